@@ -0,0 +1,85 @@
+//
+//  Copyright@2013, Illinois Rocstar LLC. All rights reserved.
+//
+//  See LICENSE file included with this source or
+//  (opensource.org/licenses/NCSA) for license information.
+//
+
+/** \file Array_allocator.hpp
+ * Contains the declaration of the allocator of the arrays of dataitems.
+ * @see Array_allocator.C DataItem.C
+ */
+
+#ifndef __COM_ARRAY_ALLOCATOR_H__
+#define __COM_ARRAY_ALLOCATOR_H__
+
+#include <cstddef>
+#include "com_basic.h"
+
+COM_BEGIN_NAME_SPACE
+
+/** Allocator of the arrays allocated by COM for dataitems.
+ *
+ *  Arrays are aligned at ALIGNMENT bytes, so that vectorized kernels can use
+ *  aligned loads. Their sizes are rounded up to size classes, four per
+ *  power of two, and the arrays released by a thread are kept in a pool of
+ *  that thread for reuse by later allocations of the same class, up to a
+ *  limit on the total size of the pool. Since a new array is zero-filled by
+ *  the thread that allocates it and recycled arrays stay with the thread
+ *  that released them, memory pages are placed by the first-touch policy
+ *  on the NUMA node of the thread that owns the array.
+ *
+ *  The memory of the arrays is obtained from a backend, which can be
+ *  replaced by set_backend(). Each array records the backend that
+ *  allocated it, so arrays allocated before a change of backend are still
+ *  released correctly.
+ */
+class Array_allocator {
+ public:
+  enum { ALIGNMENT = 64 };
+
+  /// Function that allocates nbytes bytes aligned at ALIGNMENT bytes.
+  typedef void *(*Alloc_func)(std::size_t nbytes);
+  /// Function that releases memory obtained from the Alloc_func.
+  typedef void (*Free_func)(void *p, std::size_t nbytes);
+
+  /// Allocation statistics, accumulated over all threads.
+  struct Stats {
+    long long nallocs;       ///< Number of arrays allocated
+    long long nreuses;       ///< Number of allocations served by a pool
+    long long nfrees;        ///< Number of arrays released
+    long long nbytes_inuse;  ///< Size of the arrays in use
+    long long nbytes_peak;   ///< Maximum of nbytes_inuse
+    long long nbytes_pooled; ///< Size of the arrays kept in pools
+  };
+
+  /** Allocate a zero-filled array of at least nbytes bytes aligned at
+   *  ALIGNMENT bytes. Throws COM_ERR_OUT_OF_MEMORY if it fails.
+   */
+  static void *allocate(std::size_t nbytes);
+
+  /// Release an array obtained from allocate().
+  static void deallocate(void *p);
+
+  /// Obtain the usable size of an array obtained from allocate().
+  static std::size_t capacity(const void *p);
+
+  /// Set the maximum total size of the arrays kept in the pool of each
+  /// thread. A limit of zero disables pooling.
+  static void set_pool_limit(std::size_t nbytes);
+  /// Get the maximum total size of the pool of each thread.
+  static std::size_t pool_limit();
+
+  /// Release the arrays kept in the pool of the calling thread.
+  static void release_pool();
+
+  /// Replace the backend. Passing NULL restores the default backend.
+  static void set_backend(Alloc_func alloc, Free_func free);
+
+  /// Obtain the allocation statistics.
+  static void get_stats(Stats &stats);
+};
+
+COM_END_NAME_SPACE
+
+#endif
@@ -14,6 +14,7 @@
 #define __COM_BASE_H__
 
 #include <set>
+#include "Request_pool.hpp"
 #include "com_devel.hpp"
 #include "maps.hpp"
 
@@ -102,7 +103,13 @@ class COM_base {
 
   /// Set the sizes of an dataitem. Note that for nodal or elemental data,
   /// setting sizes for one such dataitems affects all other dataitems.
-  void set_size(const std::string &wa_str, int pane_id, int nitems, int ng = 0);
+  void set_size(const std::string &wa_str, int pane_id, int nitems, int ng = 0) {
+    set_size64(wa_str, pane_id, nitems, ng);
+  }
+
+  /// Set the sizes of an dataitem with 64-bit counts.
+  void set_size64(const std::string &wa_str, int pane_id, long long nitems,
+                  long long ng = 0);
 
   /// Associates an object with a specific window.
   void set_object(const std::string &wa, const int pane_id, void *obj_addr,
@@ -183,8 +190,13 @@ class COM_base {
                     std::string *unit);
 
   /// Get the sizes of an dataitem. The opposite of set_size.
+  /// Throws COM_ERR_INVALID_SIZE if the sizes do not fit in int.
   void get_size(const std::string &wa_str, int pane_id, int *size, int *ng = 0);
 
+  /// Get the sizes of an dataitem with 64-bit counts.
+  void get_size64(const std::string &wa_str, int pane_id, long long *size,
+                  long long *ng = 0);
+
   /** Get the status of an dataitem. If the dataitem name is empty, and pane
    *  ID is 0, then checks whether the window exist (return 0 if does and -1
    *  if not); if dataitem name is empty and pane ID is >0, then check whether
@@ -267,6 +279,11 @@ class COM_base {
 
   int get_dataitem_handle(const std::string &waname);
   int get_dataitem_handle_const(const std::string &waname);
+  /// Obtains the dataitem of a handle, for modules that receive arrays of
+  /// handles rather than dataitems as arguments.
+  const DataItem *get_dataitem_object(int hdl) const {
+    return &get_dataitem(hdl);
+  }
   int get_function_handle(const std::string &wfname);
   //\}
 
@@ -314,15 +331,46 @@ class COM_base {
    *  \param lens the lengths of character strings.
    */
   void icall_function(int wf, int count, void *args[], int *reqid,
-                      const int *lens = NULL) {
-    *reqid = 0;
-    call_function(wf, count, args, lens);
-  }
+                      const int *lens = NULL);
 
   /** Wait for the completion of a nonblocking call */
-  void wait(int) {}
+  void wait(int reqid);
   /** Test whether a nonblocking call has finished. */
-  int test(int) { return 1; }
+  int test(int reqid);
+  /** Wait for the completion of all nonblocking calls */
+  void waitall();
+
+  /** Set the number of worker threads executing nonblocking calls.
+   *  If it is 0 (the default), icall_function executes the call before
+   *  returning. Otherwise, calls are queued and executed by the workers,
+   *  and calls that write to a window wait for all earlier calls accessing
+   *  that window, and vice versa. Functions called nonblockingly must be
+   *  safe to execute concurrently with the calling thread; in particular,
+   *  they must not modify the windows and should only call MPI if it was
+   *  initialized with MPI_THREAD_MULTIPLE.
+   */
+  void set_num_threads(int n);
+  /** Get the number of worker threads executing nonblocking calls. */
+  int get_num_threads() const { return _request_pool.num_threads(); }
+
+  /** Bind a function to a given list of arguments. All the argument
+   *  checking and handle resolution of call_function is performed once,
+   *  and the returned call handle can be invoked repeatedly through
+   *  invoke_function with nearly no overhead. Literal arguments are passed
+   *  by address, so their values are read at the time of each invocation.
+   *  \param wf the handle to the function.
+   *  \param count the number of input arguments.
+   *  \param args the addresses to the arguments.
+   *  \param lens the lengths of character strings.
+   *  \return the call handle (>0), or -1 if binding failed.
+   */
+  int bind_function(int wf, int count, void **args, const int *lens = NULL);
+
+  /// Invoke a function call bound by bind_function.
+  void invoke_function(int call);
+
+  /// Release a call handle obtained from bind_function.
+  void unbind_function(int call);
   //\}
 
   /** \name Profiling and tracing tools
@@ -360,6 +408,18 @@ class COM_base {
 
   enum { FPTR_NONE = 0, FPTR_INSERT = 1, FPTR_APPEND = 2 };
   int f90ptr_treat() const { return _f90ptr_treat; }
+
+  /** Get the statistics of the arrays allocated by COM for dataitems.
+   *  stats receives, in order, the numbers of allocations, of allocations
+   *  served from the pool of recycled arrays and of deallocations, and the
+   *  sizes in bytes of the arrays in use, of its peak, and of the arrays
+   *  kept in the pools. \see Array_allocator
+   */
+  static void get_allocation_stats(long long stats[6]);
+
+  /// Sets the maximum size in bytes of the recycled arrays kept per thread.
+  /// A size of zero disables the recycling of arrays.
+  static void set_allocation_pool_limit(long long nbytes);
   //\}
 
  protected:
@@ -382,6 +442,12 @@ class COM_base {
     return const_cast<COM_base *>(this)->get_window(wname);
   }
 
+  /** Look up or register the handle of an dataitem. A handle registered
+   *  before is reused without splitting its name or searching its window,
+   *  as long as the window has not changed its dataitems since.
+   */
+  int resolve_dataitem_handle(const std::string &waname, bool is_const);
+
   /// Obtains a reference to an dataitem from its handle.
   DataItem &get_dataitem(const int);
   /// Obtains a const reference to an dataitem from its handle.
@@ -409,6 +475,36 @@ class COM_base {
   void proc_exception(const COM_exception &, const std::string &);
   //\}
 
+  /** \name Bound function calls
+   * \{
+   */
+  /// A function call whose arguments have been validated and resolved.
+  struct Call_plan {
+    int wf;                   ///< Handle of the function
+    Function *func;           ///< The function object
+    std::vector<void *> args;  ///< Arguments given to bind_function
+    /// Dataitem handles copied at binding. The entries of args for
+    /// dataitem arguments point here instead of to the caller's variables.
+    std::vector<int> handles;
+    std::vector<int> lens;    ///< Lengths of character strings
+    int epoch;                ///< Value of _bind_epoch when resolved
+    bool direct;  ///< Whether it can be dispatched without call_function
+    int nps;      ///< Number of pointers passed to the function
+    void *ps[2 * Function::MAX_NUMARG + 1];  ///< Resolved pointers
+    /// Slots of ps to be refreshed with the address of a raw dataitem.
+    std::vector<std::pair<int, const DataItem *>> raws;
+    /// Windows of the dataitem arguments, and whether they are written.
+    std::vector<Request_pool::Access> windows;
+  };
+
+  /// Initialize a call plan with the given arguments and resolve it.
+  void init_call_plan(Call_plan &plan, int wf, int count, void **args,
+                      const int *lens);
+
+  /// Resolve the arguments of a call plan against the current windows.
+  void resolve_call_plan(Call_plan &plan);
+  //\}
+
  protected:
   COM_base();  // Disable default constructor
 
@@ -418,14 +514,17 @@ class COM_base {
   DataItem_map _attr_map;
   Function_map _func_map;
 
-  std::string _libdir;         ///< Library directory.
-  std::vector<double> _timer;  ///< Timers for function calls
-  int _depth;                  ///< Depth of procedure calls
-  int _verbose;                ///< Indicates whether verbose is on
+  std::string _libdir;  ///< Library directory.
+  /// Timers for function calls, depth of procedure calls, and error code
+  /// of the last call, kept per thread for the calls made by requests.
+  static thread_local std::vector<double> _timer;
+  static thread_local int _depth;
+  static thread_local int _errorcode;
+  std::mutex _profile_mutex;  ///< Guards the profile of the functions
+  int _verbose;               ///< Indicates whether verbose is on
   int _verb1;             ///< Indicates whether to print detailed information
   MPI_Comm _comm;         ///< Default communicator of COM
   bool _mpi_initialized;  ///< Indicates whether MPI was initialized by COM
-  int _errorcode;         ///< Error code
   bool _exception_on;     ///< Indicates whether COM should throw exception
   bool _profile_on;       ///< Indicates whether should profile
 
@@ -441,6 +540,16 @@ class COM_base {
                         ///< 0:  No casting to COM_Object
                         ///< 1:  Casting to COM_Object
 
+  /// Window and its revision when each dataitem handle was resolved,
+  /// indexed by handle. A NULL window marks a handle to be re-resolved.
+  std::vector<std::pair<const Window *, int>> _attr_owners;
+  /// Window of each function handle, or NULL if it must be re-resolved.
+  std::vector<const Window *> _func_owners;
+
+  std::vector<Call_plan *> _call_plans;  ///< Bound calls, indexed by handle-1
+  int _bind_epoch;  ///< Incremented whenever bound calls must be re-resolved
+  Request_pool _request_pool;  ///< Workers executing nonblocking calls
+
   static COM_base *com_base;
 };
 
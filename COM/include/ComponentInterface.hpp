@@ -38,6 +38,7 @@ class ComponentInterface {
 
  public:
   typedef std::map<int, int> Proc_map;
+  typedef DataItem::Size64 Size64;
 
   // Used by get_array. Note that the default dimension is -1, which
   // is for void*. Nonnegative dimensions are reserved for Fortran pointers.
@@ -106,7 +107,8 @@ class ComponentInterface {
    *  \param nitems total number of items (including ghosts)
    *  \param ng     number of ghosts
    */
-  void set_size(const std::string &aname, int pane_id, int nitems, int ng = 0);
+  void set_size(const std::string &aname, int pane_id, Size64 nitems,
+                Size64 ng = 0);
 
   /** Associate an array with an dataitem for a specific pane.
    *  \param aname  dataitem name
@@ -193,6 +195,9 @@ class ComponentInterface {
    */
   void get_size(const std::string &aname, int pane_id, int *nitems,
                 int *ng) const;
+  /// Get the sizes of an dataitem for a specific pane as 64-bit integers.
+  void get_size(const std::string &aname, int pane_id, Size64 *nitems,
+                Size64 *ng) const;
 
   /** Get the status of an dataitem or pane.
    *  \seealso Roccom_base::get_status()
@@ -252,6 +257,16 @@ class ComponentInterface {
   /// Return the last dataitem id.
   int last_dataitem_id() const { return _last_id; }
 
+  /// Return the revision of the dataitem table. It changes whenever an
+  /// dataitem is created, redefined, inherited or deleted, so that cached
+  /// DataItem pointers can be validated cheaply.
+  int revision() const { return _revision; }
+
+  /// Return the revision of the pane layout. It is assigned a new value,
+  /// unique among all windows, whenever the process map is rebuilt, so that
+  /// plans derived from the panes can be validated cheaply.
+  int pane_revision() const { return _pane_revision; }
+
   /// Obtain the process map
   const Proc_map &proc_map() const { return _proc_map; }
 
@@ -349,6 +364,8 @@ class ComponentInterface {
   MPI_Comm _comm;  ///< the MPI communicator of the CI.
   enum { STATUS_SHRUNK, STATUS_CHANGED, STATUS_NOCHANGE };
   int _status;  ///< Status of the CI.
+  int _revision;  ///< Revision of the dataitem table.
+  int _pane_revision;  ///< Revision of the pane layout.
 
  private:
   // Disable the following two functions (they are dangerous)
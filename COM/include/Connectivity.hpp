@@ -68,6 +68,11 @@ class Connectivity : protected DataItem {
   using DataItem::pane;
   using DataItem::Shorter_size;
   using DataItem::Size;
+  using DataItem::Size64;
+  using DataItem::capacity64;
+  using DataItem::size_of_ghost_items64;
+  using DataItem::size_of_items64;
+  using DataItem::size_of_real_items64;
   using DataItem::size_of_components;
   using DataItem::size_of_ghost_items;
   using DataItem::size_of_items;
@@ -201,9 +206,9 @@ class Connectivity : protected DataItem {
   /// Obtain the address of the jth component of the ith item, where
   /// 0<=i<size_of_items. This function is recursive and relatively expensive,
   /// and hence should be used only for performance-insenstive tasks.
-  const int *get_addr(int i, int j = 0) const;
+  const int *get_addr(Size64 i, int j = 0) const;
 
-  int *get_addr(int i, int j = 0) {
+  int *get_addr(Size64 i, int j = 0) {
     if (is_const()) throw COM_exception(COM_ERR_DATAITEM_CONST);
     return (int *)(((const Connectivity *)this)->get_addr(i, j));
   }
@@ -223,7 +228,7 @@ class Connectivity : protected DataItem {
   static const int *get_size_info(const std::string &aname);
 
   /// Allocate memory for unstructured mesh
-  void *allocate(int strd, int cap, bool force) {
+  void *allocate(int strd, Size64 cap, bool force) {
     if (!is_structured())
       return DataItem::allocate(strd, cap, force);
     else
@@ -232,12 +237,12 @@ class Connectivity : protected DataItem {
 
   /// Set the size of items and ghost items. Can be changed only if the
   /// dataitem is a root.
-  void set_size(int nitems, int ngitems = 0);
+  void set_size(Size64 nitems, Size64 ngitems = 0);
   //\}
 
  protected:
   /// Set pointer of connectivity table
-  void set_pointer(void *p, int strd, int cap, bool is_const);
+  void set_pointer(void *p, int strd, Size64 cap, bool is_const);
 
   /// Set the index of the first element.
   void set_offset(Size offset);
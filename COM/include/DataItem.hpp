@@ -8,6 +8,7 @@
 #ifndef __COM_DATAITEM_H__
 #define __COM_DATAITEM_H__
 
+#include <climits>
 #include <string>
 #include "com_exception.hpp"
 
@@ -42,6 +43,7 @@ class DataItem {
  public:
   typedef unsigned char Shorter_size;  ///< One byte unsighed int
   typedef unsigned int Size;           ///< Unsighed int
+  typedef long long Size64;            ///< Signed 64-bit count of items
 
   /** \name Constructors and destructors
    *  \{
@@ -189,9 +191,9 @@ class DataItem {
   /// Obtain the address of the jth component of the ith item, where
   /// 0<=i<size_of_items. This function is recursive and relatively expensive,
   /// and hence should be used only for performance-insenstive tasks.
-  const void *get_addr(int i, int j = 0) const;
+  const void *get_addr(Size64 i, int j = 0) const;
 
-  void *get_addr(int i, int j = 0) {
+  void *get_addr(Size64 i, int j = 0) {
     if (is_const()) throw COM_exception(COM_ERR_DATAITEM_CONST);
     return (void *)(((const DataItem *)this)->get_addr(i, j));
   }
@@ -234,22 +236,32 @@ class DataItem {
   /// Obtain the number of components in the dataitem.
   int size_of_components() const { return _ncomp; }
 
-  /// Obtain the number of items in the dataitem.
-  int size_of_items() const;
+  /** Obtain the number of items in the dataitem. The int versions of the
+   *  size queries throw COM_ERR_INVALID_SIZE if the size does not fit in an
+   *  int; the versions with suffix 64 return the full size.
+   */
+  int size_of_items() const { return checked_int(size_of_items64()); }
+  Size64 size_of_items64() const;
 
   /// Obtain the maximum allowed number of items in the dataitem.
   /// Reserved for Roccom3.1
   int maxsize_of_items() const;
 
   /// Obtain the number of ghost items in the dataitem.
-  int size_of_ghost_items() const;
+  int size_of_ghost_items() const {
+    return checked_int(size_of_ghost_items64());
+  }
+  Size64 size_of_ghost_items64() const;
 
   /// Obtain the maximum allowed number of items in the dataitem.
   /// Reserved for Roccom3.1
   int maxsize_of_ghost_items() const;
 
   /// Obtain the number of real items in the dataitem.
-  int size_of_real_items() const;
+  int size_of_real_items() const {
+    return checked_int(size_of_real_items64());
+  }
+  Size64 size_of_real_items64() const;
 
   /// Obtain the maximum allowed number of real items in the dataitem.
   /// Reserved for Roccom3.1
@@ -259,7 +271,8 @@ class DataItem {
   bool empty() const { return root()->_nitems <= 0; }
 
   /// Obtain the capacity of the array.
-  int capacity() const { return _status ? _cap : root()->_cap; }
+  int capacity() const { return checked_int(capacity64()); }
+  Size64 capacity64() const { return _status ? _cap : root()->_cap; }
 
   /// Obtain the stride of the dataitem in base datatype.
   int stride() const { return _status ? _strd : root()->_strd; }
@@ -303,12 +316,12 @@ class DataItem {
 
   /// Set the size of items and ghost items. Can be changed only if the
   /// dataitem is a root.
-  void set_size(int nitems, int ngitems = 0);
+  void set_size(Size64 nitems, Size64 ngitems = 0);
 
   /// Allocate memory for the dataitem.
   /// The dataitem must be a root if the dataitem is to be allocated.
   /// If from is not NULL, copy its value to the newly allocated array.
-  void *allocate(int strd, int cap, bool force);
+  void *allocate(int strd, Size64 cap, bool force);
 
   /// Deallocate memory if it was allocated by allocate().
   /// Return 0 if deallocation is successful.
@@ -317,15 +330,24 @@ class DataItem {
   enum Copy_dir { COPY_IN, COPY_OUT };
   // Copy n _ncomp-vectors from "buf" to the array if direction is COPY_IN
   // or copy to "buf" if direction is COPY_OUT.
-  void copy_array(void *buf, int strd, int nitem, int offset = 0,
+  void copy_array(void *buf, int strd, Size64 nitem, Size64 offset = 0,
                   int direction = COPY_IN);
 
   // Append n _ncomp-vectors from "from" to the array.
-  void append_array(const void *from, int strd, int nitem);
+  void append_array(const void *from, int strd, Size64 nitem);
 
  protected:
   /// Set the physical address of the dataitem values.
-  void set_pointer(void *p, int strd, int cap, int offset, bool is_const);
+  void set_pointer(void *p, int strd, Size64 cap, int offset, bool is_const);
+
+  /// Convert a size to int, or throw COM_ERR_INVALID_SIZE if it overflows.
+  int checked_int(Size64 n) const {
+    if (n > INT_MAX) throw_size_overflow();
+    return int(n);
+  }
+
+  /// Throw COM_ERR_INVALID_SIZE for a size that overflows an int.
+  void throw_size_overflow() const;
 
   /// Inherit from parent. If depth>0, then the procedure is for the
   /// subcomponents.
@@ -346,8 +368,8 @@ class DataItem {
   COM_Type _type;     ///< Base data type of the dataitem.
   std::string _unit;  ///< Unit of the dataitem.
 
-  int _nitems;   ///< Size of total items. Default value is -1.
-  int _ngitems;  ///< Size of ghost items
+  Size64 _nitems;   ///< Size of total items. Default value is -1.
+  Size64 _ngitems;  ///< Size of ghost items
   int _gap;      ///< Gap between the IDs of real and ghost items.
 
   enum {
@@ -362,7 +384,7 @@ class DataItem {
   void *_ptr;        ///< Physical address of the dataitem.
   int _strd;         ///< Stride
   int _nbytes_strd;  ///< Number of bytes of the stride
-  int _cap;          ///< Capacity
+  Size64 _cap;       ///< Capacity
 
   static const char *_keywords[COM_NUM_KEYWORDS];     ///< List of keywords
   static const char _keylocs[COM_NUM_KEYWORDS];       ///< Default locations
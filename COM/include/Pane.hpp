@@ -27,6 +27,7 @@ class Pane {
   typedef std::vector<DataItem *> DataGroup;     ///< Vector of dataitems.
   typedef std::vector<Connectivity *> Cnct_set;  ///< Vector of connectivities.
   typedef unsigned int Size;                     ///< Unsighed int.
+  typedef DataItem::Size64 Size64;  ///< Signed 64-bit count of items.
   enum OP_Init { OP_SET = 1, OP_SET_CONST, OP_ALLOC, OP_RESIZE, OP_DEALLOC };
   enum Inherit_Modes { INHERIT_USE = 0, INHERIT_CLONE, INHERIT_COPY };
 
@@ -288,7 +289,8 @@ class Pane {
   /// Delete an existing dataitem with given id.
   void delete_dataitem(int id);
 
-  void reinit_dataitem(int aid, OP_Init op, void **addr, int strd, int cap);
+  void reinit_dataitem(int aid, OP_Init op, void **addr, int strd,
+                       Size64 cap);
 
   /// Obtain the connectivity with the given name.
   const Connectivity *connectivity(const std::string &a) const {
@@ -298,17 +300,17 @@ class Pane {
   Connectivity *connectivity(const std::string &a, bool insert = false);
 
   void reinit_conn(Connectivity *con, OP_Init op, int **addr, int strd,
-                   int cap);
+                   Size64 cap);
 
   /// Inherit an dataitem from another pane onto the current pane:
   DataItem *inherit(DataItem *from, const std::string &aname, int mode,
                     bool withghost);
 
   /// Set the size of an dataitem
-  void set_size(DataItem *a, int nitems, int ng);
+  void set_size(DataItem *a, Size64 nitems, Size64 ng);
 
   /// Set the size of a connectivity table.
-  void set_size(Connectivity *con, int nitems, int ng);
+  void set_size(Connectivity *con, Size64 nitems, Size64 ng);
 
  protected:
   ComponentInterface *_window;  ///< Point to the parent window.
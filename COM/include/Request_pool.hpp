@@ -0,0 +1,138 @@
+//
+//  Copyright@2013, Illinois Rocstar LLC. All rights reserved.
+//
+//  See LICENSE file included with this source or
+//  (opensource.org/licenses/NCSA) for license information.
+//
+
+/** \file Request_pool.hpp
+ * Contains the declaration of the worker pool behind nonblocking calls.
+ * @see Request_pool.C COM_base.hpp
+ */
+
+#ifndef __COM_REQUEST_POOL_H__
+#define __COM_REQUEST_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "com_basic.h"
+
+COM_BEGIN_NAME_SPACE
+
+/** A pool of worker threads executing the requests of nonblocking function
+ *  calls. Each request declares the windows it reads and writes. A request
+ *  is started only after all earlier requests that write a window it
+ *  accesses, or access a window it writes, have completed, so that
+ *  conflicting calls are executed in the order they were submitted.
+ *  With zero threads, requests are executed by the submitting thread.
+ */
+class Request_pool {
+ public:
+  typedef std::function<void()> Task;
+  /// A window accessed by a request, and whether it is written.
+  /// A NULL window stands for every window.
+  typedef std::pair<const void *, bool> Access;
+
+  Request_pool() : _nthreads(0), _next_id(1), _nactive(0), _stop(false) {}
+  ~Request_pool() { set_num_threads(0); }
+
+  /// Change the number of worker threads after completing all requests.
+  void set_num_threads(int n);
+  /// Get the number of worker threads.
+  int num_threads() const { return _nthreads; }
+
+  /// Whether there is no request in flight.
+  bool idle() const { return _nactive == 0; }
+
+  /// Submit a request and return its ID.
+  int submit(const Task &task, const std::vector<Access> &accesses);
+
+  /** Wait for the completion of a request and release it.
+   *  \return the error code of the request, and set msg to its message.
+   *  Returns -1 if the request is unknown.
+   */
+  int wait(int id, std::string *msg = NULL);
+
+  /** Test whether a request has completed, and release it if so.
+   *  \return 1 if completed and 0 otherwise, and set ierr and msg to
+   *  the error code and message of a completed request.
+   */
+  int test(int id, int *ierr, std::string *msg = NULL);
+
+  /// Wait for the completion of all requests in flight. From within a
+  /// request, wait as wait_for() does for an access to every window.
+  void waitall();
+
+  /** Wait for the completion of the requests in flight that conflict
+   *  with the given accesses.
+   *
+   *  From within a request, the accesses are added to those of the
+   *  request, so that the requests submitted after it and not yet started
+   *  wait for it, and only the conflicting requests submitted before it or
+   *  already running are waited for. The earlier requests ready to run are
+   *  executed by the calling thread. Throws COM_ERR_NESTED_WAIT if a
+   *  running request is waiting for the calling one.
+   */
+  void wait_for(const std::vector<Access> &accesses);
+
+  /// Whether the calling thread is executing a request.
+  static bool in_request() { return _current != NULL; }
+
+ protected:
+  /// State of a request in flight.
+  struct Request {
+    int id;
+    Task task;
+    std::vector<Access> accesses;
+    bool running;
+    const Request *waiting;  ///< Running request it is waiting for
+  };
+  /// Outcome of a completed request.
+  struct Outcome {
+    int ierr;
+    std::string msg;
+  };
+
+  /// Whether two lists of accesses conflict.
+  static bool conflict(const std::vector<Access> &a,
+                       const std::vector<Access> &b);
+
+  /// Whether any request before r in the queue conflicts with it.
+  bool blocked(std::list<Request *>::const_iterator r) const;
+
+  /// Wait from within the request cur for the conflicting requests
+  /// submitted before it or running.
+  void wait_nested(Request *cur, const std::vector<Access> &accesses,
+                   std::unique_lock<std::mutex> &lock);
+
+  /// Execute a request and record its outcome.
+  void execute(Request *r, std::unique_lock<std::mutex> &lock);
+
+  /// Main loop of a worker thread.
+  void work();
+
+ protected:
+  std::vector<std::thread> _threads;      ///< Worker threads
+  int _nthreads;                          ///< Number of worker threads
+  int _next_id;                           ///< ID of the next request
+  std::atomic<int> _nactive;              ///< Number of requests in flight
+  bool _stop;                             ///< Whether workers should exit
+  static thread_local Request *_current;  ///< Request run by this thread
+
+  std::list<Request *> _queue;       ///< Requests in flight in order
+  std::map<int, Outcome> _complete;  ///< Completed but not yet released
+  std::mutex _mutex;
+  std::condition_variable _work_cond;  ///< Signaled when work is available
+  std::condition_variable _done_cond;  ///< Signaled when a request completes
+};
+
+COM_END_NAME_SPACE
+
+#endif
@@ -168,6 +168,18 @@ inline void COM_set_size(const std::string &wa_str, int pane_id, int size,
                          int ng = 0) {
   COM_get_com()->set_size(wa_str, pane_id, size, ng);
 }
+#endif
+
+inline void COM_set_size64(const char *wa_str, int pane_id, long long size,
+                           long long ng = 0) {
+  COM_get_com()->set_size64(wa_str, pane_id, size, ng);
+}
+
+#ifndef C_ONLY
+inline void COM_set_size64(const std::string &wa_str, int pane_id,
+                           long long size, long long ng = 0) {
+  COM_get_com()->set_size64(wa_str, pane_id, size, ng);
+}
 
 template <class Type>
 inline void COM_set_object(const std::string &wa_str, int pane_id, Type *addr) {
@@ -336,6 +348,18 @@ inline void COM_get_size(const std::string &wa_str, int pane_id, int *size,
 }
 #endif
 
+inline void COM_get_size64(const char *wa_str, int pane_id, long long *size,
+                           long long *ng = 0) {
+  COM_get_com()->get_size64(wa_str, pane_id, size, ng);
+}
+
+#ifndef C_ONLY
+inline void COM_get_size64(const std::string &wa_str, int pane_id,
+                           long long *size, long long *ng = nullptr) {
+  COM_get_com()->get_size64(wa_str, pane_id, size, ng);
+}
+#endif
+
 #ifndef C_ONLY
 template <class Type>
 inline void COM_get_array(const char *wa_str, int pane_id, Type **addr,
@@ -701,10 +725,72 @@ inline void COM_icall_function(const int wf, const void *wa1, const void *wa2,
 }
 #endif
 
+/* Bind a function registered to COM to a list of arguments. */
+extern "C" int COM_bind_function(const int wf, int argc, ...);
+
+#ifndef C_ONLY
+// Bound function calls
+inline int COM_bind_function(const int wf) {
+  return COM_get_com()->bind_function(wf, 0, nullptr);
+}
+inline int COM_bind_function(const int wf, const void *wa) {
+  return COM_get_com()->bind_function(wf, 1, (void **)&wa);
+}
+inline int COM_bind_function(const int wf, const void *wa1, const void *wa2) {
+  const void *args[] = {wa1, wa2};
+  return COM_get_com()->bind_function(wf, 2, (void **)args);
+}
+inline int COM_bind_function(const int wf, const void *wa1, const void *wa2,
+                             const void *wa3) {
+  const void *args[] = {wa1, wa2, wa3};
+  return COM_get_com()->bind_function(wf, 3, (void **)args);
+}
+inline int COM_bind_function(const int wf, const void *wa1, const void *wa2,
+                             const void *wa3, const void *wa4) {
+  const void *args[] = {wa1, wa2, wa3, wa4};
+  return COM_get_com()->bind_function(wf, 4, (void **)args);
+}
+
+inline int COM_bind_function(const int wf, const void *wa1, const void *wa2,
+                             const void *wa3, const void *wa4,
+                             const void *wa5) {
+  const void *args[] = {wa1, wa2, wa3, wa4, wa5};
+  return COM_get_com()->bind_function(wf, 5, (void **)args);
+}
+
+inline int COM_bind_function(const int wf, const void *wa1, const void *wa2,
+                             const void *wa3, const void *wa4, const void *wa5,
+                             const void *wa6) {
+  const void *args[] = {wa1, wa2, wa3, wa4, wa5, wa6};
+  return COM_get_com()->bind_function(wf, 6, (void **)args);
+}
+
+inline int COM_bind_function(const int wf, const void *wa1, const void *wa2,
+                             const void *wa3, const void *wa4, const void *wa5,
+                             const void *wa6, const void *wa7) {
+  const void *args[] = {wa1, wa2, wa3, wa4, wa5, wa6, wa7};
+  return COM_get_com()->bind_function(wf, 7, (void **)args);
+}
+#endif
+
+inline void COM_invoke_function(const int call) {
+  COM_get_com()->invoke_function(call);
+}
+
+inline void COM_unbind_function(const int call) {
+  COM_get_com()->unbind_function(call);
+}
+
 inline void COM_wait(const int id) { COM_get_com()->wait(id); }
 
 inline int COM_test(const int id) { return COM_get_com()->test(id); }
 
+inline void COM_waitall() { COM_get_com()->waitall(); }
+
+inline void COM_set_num_threads(int n) { COM_get_com()->set_num_threads(n); }
+
+inline int COM_get_num_threads() { return COM_get_com()->get_num_threads(); }
+
 inline void COM_set_verbose(int i) { COM_get_com()->set_verbose(i); }
 
 // Profiling tools
@@ -735,6 +821,14 @@ inline int COM_compatible_types(COM_Type type1, COM_Type type2) {
 
 inline int COM_get_error_code() { return COM_get_com()->get_error_code(); }
 
+inline void COM_get_allocation_stats(long long *stats) {
+  COM::COM_base::get_allocation_stats(stats);
+}
+
+inline void COM_set_allocation_pool_limit(long long nbytes) {
+  COM::COM_base::set_allocation_pool_limit(nbytes);
+}
+
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 #endif /* __COM_CPP_H__ */
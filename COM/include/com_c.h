@@ -116,6 +116,11 @@ void COM_delete_dataitem(const char *wa_str);
  */
 void COM_set_size(const char *wa_str, int pane_id, int size, int ng);
 
+/** Set sizes of for a specific dataitem with 64-bit counts.
+ */
+void COM_set_size64(const char *wa_str, int pane_id, long long size,
+                    long long ng);
+
 /** Associates an array with an dataitem for a specific pane.
  */
 void COM_set_array(const char *wa_str, int pane_id, void *addr, int strd,
@@ -168,6 +173,10 @@ void COM_deallocate_array(const char *wa_str, const int pid);
 /** Get the sizes of an dataitem. The opposite of set_size. */
 void COM_get_size(const char *wa_str, int pane_id, int *size, int *ng);
 
+/** Get the sizes of an dataitem with 64-bit counts. */
+void COM_get_size64(const char *wa_str, int pane_id, long long *size,
+                    long long *ng);
+
 /** Get the sizes of an dataitem. The opposite of set_size. */
 void COM_get_dataitem(const char *wa_str, char *loc, int *type, int *ncomp,
                       char *unit, int n);
@@ -241,6 +250,16 @@ void COM_icall_function(const int wf, int argc, ...);
 
 void COM_wait(const int id);
 int COM_test(const int id);
+void COM_waitall();
+
+/* Number of worker threads executing nonblocking calls. */
+void COM_set_num_threads(int n);
+int COM_get_num_threads();
+
+/* Bind a function to a list of arguments once, and invoke it repeatedly. */
+int COM_bind_function(const int wf, int argc, ...);
+void COM_invoke_function(const int call);
+void COM_unbind_function(const int call);
 
 /**\}*/
 
@@ -260,6 +279,10 @@ int COM_get_sizeof(const COM_Type type, int c);
 int COM_compatible_types(COM_Type type1, COM_Type type2);
 
 int COM_get_error_code();
+
+/* Statistics and pool size of the arrays allocated by COM. */
+void COM_get_allocation_stats(long long *stats);
+void COM_set_allocation_pool_limit(long long nbytes);
 /*\}*/
 #ifdef __cplusplus
 }
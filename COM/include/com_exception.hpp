@@ -69,6 +69,7 @@ enum Error_code {
   COM_ERR_GHOST_ELEMS,
   COM_ERR_GHOST_LAYERS,
   COM_ERR_APPEND_ARRAY,
+  COM_ERR_NESTED_WAIT,
   COM_UNKNOWN_ERROR
 };
 
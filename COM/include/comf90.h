@@ -142,6 +142,12 @@
            CHARACTER(*), INTENT( IN) :: ANAME
            INTEGER, INTENT(IN)       :: PANE_ID, SIZE_TOTAL, SIZE_GHOST
          END SUBROUTINE COM_SET_SIZE2
+
+         SUBROUTINE COM_SET_SIZE64( ANAME, PANE_ID, SIZE_TOTAL, SIZE_GHOST)
+           CHARACTER(*), INTENT( IN) :: ANAME
+           INTEGER, INTENT(IN)       :: PANE_ID
+           INTEGER(8), INTENT(IN)    :: SIZE_TOTAL, SIZE_GHOST
+         END SUBROUTINE COM_SET_SIZE64
       END INTERFACE
 
       INTERFACE COM_SET_ARRAY
@@ -1684,6 +1690,12 @@
            INTEGER, INTENT(IN)       :: PANE_ID
            INTEGER, INTENT(OUT)      :: SIZE_TOTAL, SIZE_GHOST
          END SUBROUTINE COM_GET_SIZE2
+
+         SUBROUTINE COM_GET_SIZE64( ANAME, PANE_ID, SIZE_TOTAL, SIZE_GHOST)
+           CHARACTER(*), INTENT( IN) :: ANAME
+           INTEGER, INTENT(IN)       :: PANE_ID
+           INTEGER(8), INTENT(OUT)   :: SIZE_TOTAL, SIZE_GHOST
+         END SUBROUTINE COM_GET_SIZE64
       END INTERFACE
 
       INTERFACE
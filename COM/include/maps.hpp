@@ -9,6 +9,8 @@
 #define __COM_MAPS_H__
 
 #include <list>
+#include <string>
+#include <vector>
 #include "com_basic.h"
 #include "com_exception.hpp"
 
@@ -16,14 +18,20 @@ COM_BEGIN_NAME_SPACE
 
 /// Supports mapping from names to handles and vice-versa for
 /// a module, window, function, or attribute.
+///
+/// Names are indexed by an open-addressing hash table with linear probing.
+/// The hash value of each name and whether it was registered as const are
+/// cached with the entry, so that lookups compare strings only on a hash
+/// match and is_immutable() is a bit test. Lookups do not modify the map,
+/// so that any number of threads may look up names concurrently, as long as
+/// no thread adds or removes an object at the same time.
 template <class Object>
 class COM_map {
-  typedef std::vector<Object> I2O;         ///< Mapping from indices to objects
-  typedef std::map<std::string, int> N2I;  ///< Mapping from names to indices
+  typedef std::vector<Object> I2O;  ///< Mapping from indices to objects
  public:
   typedef Object value_type;
 
-  COM_map() {}
+  COM_map() : nslots(0) {}
   ~COM_map() {}
 
   /// Insert an object into the table.
@@ -33,9 +41,7 @@ class COM_map {
   void remove_object(std::string name, bool is_const = false);
 
   /// whether the object mutable
-  bool is_immutable(int i) const {
-    return names[i].find(" (const)") != std::string::npos;
-  }
+  bool is_immutable(int i) const { return flags[i] & FLAG_CONST; }
 
   /// Access an object using its handle.
   const Object &operator[](int i) const {
@@ -55,56 +61,111 @@ class COM_map {
 
   std::pair<int, Object *> find(const std::string &name,
                                 bool is_const = false) {
-    N2I::iterator it = n2i.find(is_const ? name + "(const)" : name);
-    if (it == n2i.end())
+    int i = find_index(name, is_const);
+    if (i < 0)
       return std::pair<int, Object *>(-1, NULL);
     else
-      return std::pair<int, Object *>(it->second, &i2o[it->second]);
+      return std::pair<int, Object *>(i, &i2o[i]);
   }
 
+  /// Find the index of an object from its name without modifying the map.
+  /// Returns -1 if the name is not found.
+  int find_index(const std::string &name, bool is_const = false) const;
+
   std::vector<std::string> get_names() { return names; }
 
+  /// Compute the FNV-1a hash value of a name.
+  static std::size_t hash_name(const std::string &name) {
+    std::size_t h = 2166136261u;
+    for (std::string::size_type i = 0, n = name.size(); i < n; ++i)
+      h = (h ^ (unsigned char)name[i]) * 16777619u;
+    return h;
+  }
+
  protected:
+  enum { FLAG_CONST = 1 };
+  enum { EMPTY_SLOT = -1 };
+  enum { SUFFIX_LEN = 8 };  ///< Size of the suffix " (const)"
+
+  /// Whether entry i is the given name with the given constness.
+  bool matches(int i, const std::string &name, std::size_t h,
+               bool is_const) const {
+    if (hashes[i] != h || bool(flags[i] & FLAG_CONST) != is_const) return false;
+    const std::string &n = names[i];
+    return n.size() == name.size() + (is_const ? SUFFIX_LEN : 0) &&
+           n.compare(0, name.size(), name) == 0;
+  }
+
+  /// Insert index i into the hash table, which must have a free slot.
+  void insert_slot(int i) {
+    std::size_t s = hashes[i] & (nslots - 1);
+    while (slots[s] != EMPTY_SLOT) s = (s + 1) & (nslots - 1);
+    slots[s] = i;
+  }
+
+  /// Rebuild the hash table with at least twice as many slots as entries.
+  void rehash() {
+    nslots = 16;
+    while (nslots < 2 * names.size()) nslots *= 2;
+    slots.assign(nslots, EMPTY_SLOT);
+    for (int i = 0, n = names.size(); i < n; ++i) insert_slot(i);
+  }
+
   I2O i2o;                         ///< Mapping from index to objects
-  N2I n2i;                         ///< Mapping from names to indices
   std::vector<std::string> names;  ///< Name of the objects
+  std::vector<std::size_t> hashes;  ///< Hash values of the names without
+                                    ///< the const suffix
+  std::vector<unsigned char> flags;  ///< Flags of the objects
+  std::vector<int> slots;  ///< Open-addressing table of indices
+  std::size_t nslots;      ///< Number of slots; always a power of two
 };
 
 template <class Object>
-int COM_map<Object>::add_object(std::string name, Object t, bool is_const) {
-  if (is_const) name.append(" (const)");
+int COM_map<Object>::find_index(const std::string &name, bool is_const) const {
+  if (nslots == 0) return -1;
+  std::size_t h = hash_name(name);
+  for (std::size_t s = h & (nslots - 1);; s = (s + 1) & (nslots - 1)) {
+    int i = slots[s];
+    if (i == EMPTY_SLOT) return -1;
+    if (matches(i, name, h, is_const)) return i;
+  }
+}
 
-  N2I::iterator it = n2i.find(name);
-  int i = (it == n2i.end()) ? -1 : it->second;
+template <class Object>
+int COM_map<Object>::add_object(std::string name, Object t, bool is_const) {
+  int i = find_index(name, is_const);
 
-  if (i > 0) {
+  if (i >= 0) {
     i2o[i] = t;
   } else {
     i = i2o.size();
-    n2i[name] = i;
+    std::size_t h = hash_name(name);
+    if (is_const) name.append(" (const)");
     i2o.push_back(t);
     names.push_back(name);
+    hashes.push_back(h);
+    flags.push_back(is_const ? FLAG_CONST : 0);
+
+    if (2 * names.size() > nslots)
+      rehash();
+    else
+      insert_slot(i);
   }
   return i;
 }
 
 template <class Object>
 void COM_map<Object>::remove_object(std::string name, bool is_const) {
-  if (is_const) name.append(" (const)");
-
-  N2I::iterator it = n2i.find(name);
-  if (it == n2i.end()) throw COM_exception(COM_UNKNOWN_ERROR);
-  int i = it->second;
-  n2i.erase(it);
-  it = n2i.begin();
-  while (it != n2i.end()) {
-    if (it->second > i) it->second--;
-    it++;
-  }
-  typename I2O::iterator oi = i2o.begin() + i;
-  i2o.erase(oi);
-  std::vector<std::string>::iterator ni = names.begin() + i;
-  names.erase(ni);
+  int i = find_index(name, is_const);
+  if (i < 0) throw COM_exception(COM_UNKNOWN_ERROR);
+
+  i2o.erase(i2o.begin() + i);
+  names.erase(names.begin() + i);
+  hashes.erase(hashes.begin() + i);
+  flags.erase(flags.begin() + i);
+
+  // Indices after i have shifted, so rebuild the table.
+  rehash();
 }
 
 class Function;
@@ -128,6 +189,7 @@ class Function_map : protected COM_map<Function *> {
     return i;
   }
 
+  using Base::find_index;
   using Base::name;
   using Base::operator[];
   using Base::size;
@@ -29,6 +29,7 @@ public:
   static int sum_scalar_MPI;
   static int nrm2_scalar_MPI;
   static int maxof_scalar;
+  static int fused_MPI;
 };
 
 #endif //_ROCBLAS_SIM_H_
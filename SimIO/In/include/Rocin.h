@@ -8,12 +8,19 @@
 /** \file Rocin.h
  *  Rocin creates a series of Roccom windows by reading in a list of files.
  *  Rocin can also copy Roccom dataitems from window to window.
- *  Only HDF4 files are supported in the current implementation.
+ *  HDF4 or CGNS files are supported, depending on the build, as well as
+ *  the native snapshot files, which are mapped into memory.
  */
 
 #ifndef _ROCIN_H_
 #define _ROCIN_H_
 
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Snapshot.h"
 #include "com.h"
 #include "com_devel.hpp"
 #include "rocin_block.h"
@@ -47,6 +54,9 @@ class Rocin : public COM_Object {
   /// Default constructor
   Rocin() : m_is_local(NULL), m_base(0), m_offset(0) {}
 
+  /// Destructor, which unmaps the snapshot files.
+  ~Rocin();
+
   /// Pointer to a function to determine locality of a pane.
   typedef void (*RulesPtr)(const int &pane_id, const int &comm_rank,
                            const int &comm_size, int *is_local);
@@ -154,6 +164,35 @@ class Rocin : public COM_Object {
   void read_parameter_file(const char *file_name, const char *window_name,
                            const MPI_Comm *comm = NULL);
 
+  /** Set an option for Rocin.
+   *
+   * The option "scan" selects how read_windows obtains the metadata of the
+   * files: "all" (default) lets every process scan every file it matched,
+   * and "distributed" lets each process scan a share of the files matched
+   * by all the processes and exchanges the metadata. The option
+   * "scan_index", used with distributed scans, names the files in which the
+   * metadata is saved, so that later reads of the same unchanged files
+   * skip the scan. The metadata of each format is saved in the given name
+   * followed by the format, such as "index.cgns" and "index.hdf4". Only
+   * process 0 reads or writes those files.
+   *
+   * The option "prefetch" ("on" by default) asks the kernel to read the
+   * next file of the local panes into the page cache while a file is
+   * read. The option "readers" sets the number of threads that map and
+   * decompress snapshot files concurrently. The HDF4 and CGNS libraries
+   * are not thread-safe, so their files are read by the calling thread.
+   *
+   * The arrays of snapshot files are copied into arrays allocated by COM.
+   * With the option "mapped" on, they are used in place in the mapped
+   * files instead, which stay mapped until this module is unloaded. The
+   * windows read must then be deleted before unloading it.
+   *
+   * \param option_name the option name: "scan", "scan_index", "prefetch",
+   *        "readers" or "mapped".
+   * \param option_val the option value.
+   */
+  void set_option(const char *option_name, const char *option_val);
+
   //\}
 
  protected:
@@ -188,6 +227,26 @@ class Rocin : public COM_Object {
                       const std::string &window, RulesPtr is_local,
                       const MPI_Comm *comm, int rank, int nprocs);
 
+  /** Create windows from snapshot files.
+   *
+   * The arrays of the panes refer to the mapped files where their layouts
+   * match the dataitems, so they are not copied. The files remain mapped
+   * until the module is unloaded.
+   * The arrays of a delta that refer to earlier writes are read from the
+   * files they refer to, which are mapped as well.
+   *
+   * \param files the snapshot files of this process.
+   * \param window_prefix the prefix of the window names.
+   * \param materials the materials to read, or empty for all.
+   * \param time the time level to read, or empty for the first one, which
+   *        is then returned.
+   */
+  void read_snapshots(const std::vector<std::string> &files,
+                      const std::string &window_prefix,
+                      const std::set<std::string> &materials,
+                      const MPI_Comm *comm, RulesPtr is_local,
+                      std::string &time, int rank, int nprocs);
+
   //\}
 
  protected:
@@ -219,6 +278,9 @@ class Rocin : public COM_Object {
   std::set<int> m_pane_ids;
   int m_base;
   int m_offset;
+  /// Snapshot files mapped for arrays used in place
+  std::vector<Snapshot_file *> m_snapshots;
+  std::map<std::string, std::string> m_options;  ///< Options of Rocin
 
 #ifdef USE_HDF4
   std::map<int32, COM_Type> m_HDF2COM;
@@ -7,7 +7,18 @@
 #ifndef _ROCOUT_H_
 #define _ROCOUT_H_
 
+#include <atomic>
 #include <map>
+#include <set>
+#include <string>
+#include <vector>
+#ifdef USE_PTHREADS
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif  // USE_PTHREADS
+#include "Rocout_snap.h"
 #include "com.h"
 #include "com_devel.hpp"
 
@@ -21,8 +32,44 @@ extern "C" void SimOUT_load_module(const char *name);
 extern "C" void SimOUT_unload_module(const char *name);
 //\}
 
+class CGNS_files;
+class HDF4_files;
+
+//! A write prepared by the calling thread for write_dataitem_internal.
+struct WriteAttrInfo {
+  WriteAttrInfo()
+      : m_attr(NULL),
+        m_snapshot(NULL),
+        m_direct(false),
+        m_cgnsFiles(NULL),
+        m_hdf4Files(NULL) {}
+
+  const COM::DataItem *m_attr;  ///< The dataitem to write, or its copy
+  COM::Window *m_snapshot;      ///< The window of the copy, if copied
+  std::vector<char> m_buffer;   ///< The arrays of the copy, if not owned
+                                ///< by m_snapshot
+  std::string m_material;
+  std::string m_timelevel;
+  std::string m_format;
+  std::string m_ghosthandle;
+  std::string m_errorhandle;
+  bool m_direct;  ///< Write snapshot files with O_DIRECT
+  Snapshot::Compression m_compression;  ///< Compression of snapshot files
+  CGNS_files *m_cgnsFiles;  ///< The CGNS files kept open, if any
+  HDF4_files *m_hdf4Files;  ///< The HDF4 files kept open, if any
+  std::vector<int> m_panes;           ///< The panes to write
+  std::vector<std::string> m_fnames;  ///< The data file of each pane
+  std::vector<std::string> m_mfiles;  ///< The mesh file of each pane
+  std::vector<int> m_modes;           ///< Write (0) or append (1) each pane
+  std::vector<SNAP_refs> m_refs;      ///< The unchanged arrays of each pane
+  /// The hashes of the arrays of each pane written in full
+  std::vector<std::map<std::string, unsigned long long> > m_hashes;
+};
+
 class Rocout : public COM_Object {
  public:
+  Rocout();
+
   /** \name User interface
    *  \{
    */
@@ -74,10 +121,19 @@ class Rocout : public COM_Object {
                     const char *mfile_pre = NULL, const MPI_Comm *comm = NULL,
                     const int *pane_id = NULL);
 
-  /** Wait for the completion of an asychronous write operation.
+  /** Wait for the completion of all asychronous write operations, and
+   *  close the files kept open between writes.
    */
   void sync();
 
+  /** Obtain the progress of the write operations.
+   *
+   * \param nsubmitted the number of writes submitted so far.
+   * \param ncompleted the number of writes completed so far. All writes
+   *        have completed when it equals nsubmitted.
+   */
+  void get_progress(int *nsubmitted, int *ncompleted);
+
   /** Generate a control file for Rocin.
    *
    * \param window_name The name of the Roccom window.
@@ -90,9 +146,39 @@ class Rocout : public COM_Object {
 
   /** Set an option for Rocout, such as controlling the output format.
    *
-   * \param option_name the option name: "format", "async", "mode",
-   *        "localdir", "rankwidth", "pnidwidth", "separator" or "errorhandle".
+   * \param option_name the option name: "format", "async", "writers",
+   *        "aggregate", "direct", "delta", "compress", "openfiles", "mode",
+   *        "localdir", "rankwidth", "pnidwidth", "separator" or
+   *        "errorhandle".
    * \param option_val the option value.
+   *
+   * With "async" on, "writers" sets the number of threads writing the
+   * queued writes. Writes to different files may run concurrently, while
+   * the writes to a file are done in the order they were submitted.
+   *
+   * With "aggregate" set to n > 1, the panes of each group of n
+   * consecutive ranks of the communicator are gathered onto the first rank
+   * of the group, which writes them to its file. Writes of all panes are
+   * then collective over the group: its ranks must make the same writes,
+   * in the same order.
+   *
+   * With "delta" set to n > 0, the SNAP format writes n deltas after each
+   * full dump of a material, where a dump is the writes of one time level:
+   * the arrays that have not changed since they were last written are
+   * written as references to that write. The files referred to must be
+   * kept, and must not be written again.
+   *
+   * "compress" sets the compression of the arrays of the SNAP format, such
+   * as "shuffle+zlib:3". See Snapshot::parse_compression.
+   *
+   * With "openfiles" set to n > 0, the CGNS and HDF4 formats keep up to
+   * n files of each format open between writes, so that the writes and
+   * appends to a file do not open and close it each time. The CGNS format
+   * also keeps the time values of the bases in memory, so that appending
+   * a time level does not read and rewrite those written before. The
+   * files are closed, and complete, after sync(), at finalization, or
+   * when a window written to them is deleted, before the next write. The
+   * HDF4 files kept open are written with the SD interface.
    */
   void set_option(const char *option_name, const char *option_val);
 
@@ -144,11 +230,49 @@ class Rocout : public COM_Object {
   /** \name Implementation
    * \{
    */
+  /** Write a dataitem to file, synchronously or through the writer
+   *  threads depending on the "async" option.
+   *
+   * \param append 0 to write a new file, 1 to append to a file, or -1
+   *        to follow the "mode" option.
+   */
+  void write(const char *filename_pre, const COM::DataItem *attr,
+             const char *material, const char *timelevel,
+             const char *mfile_pre, const MPI_Comm *comm, const int *pane_id,
+             int append);
+
+#ifndef DUMMY_MPI
+  /** Gather the panes of a dataitem from the ranks of an aggregation
+   *  group onto the first rank of the group, which is its aggregator.
+   *
+   * On the aggregator, ai receives a window of all the panes of the group
+   * in m_snapshot, the dataitem to write in m_attr and the arrays in
+   * m_buffer. Other ranks only send their panes.
+   *
+   * \param attr the dataitem to write.
+   * \param comm the communicator of the write.
+   * \param ratio the number of ranks per group.
+   * \return the rank of the aggregator in comm.
+   */
+  int aggregate_panes(WriteAttrInfo *ai, const COM::DataItem *attr,
+                      MPI_Comm comm, int ratio);
+#endif  // DUMMY_MPI
+
+  /** Find the arrays of a write that have not changed since they were
+   *  last written, and set them as its references in m_refs, unless a
+   *  full dump is due. The hashes of the others are set in m_hashes.
+   */
+  void find_unchanged(WriteAttrInfo *ai);
+
   /** Does the actual writing to file.
    *
-   * \param attrInfo Information on what to write and where to write it.
+   * \param ai Information on what to write and where to write it.
    */
-  static void *write_dataitem_internal(void *attrInfo);
+  void write_dataitem_internal(const WriteAttrInfo &ai);
+
+  /// Record the arrays of a pane written in full by a SNAP write, so that
+  /// later deltas refer to them.
+  void record_written(const WriteAttrInfo &ai, std::size_t i);
 
   /** Builds a filename from the given prefix and rank.
    *
@@ -159,12 +283,76 @@ class Rocout : public COM_Object {
    */
   std::string get_fname(const std::string &pre, int rank = -1,
                         const int paneId = 0, bool check = false);
+
+  /// Close the files kept open between writes. Writes must have completed.
+  void close_files();
+
+  /// Close the files kept open, after completing the writes, if a window
+  /// written to them has been deleted.
+  void check_windows();
   //\}
 
+#ifdef USE_PTHREADS
+  /** \name Writer threads
+   * \{
+   */
+  /// Queue a write whose data has been copied, blocking while the queue
+  /// is full.
+  void enqueue(WriteAttrInfo *ai);
+
+  /// Find the first queued write that touches no file of a running or
+  /// earlier queued write. Called with _mutex held.
+  std::deque<WriteAttrInfo *>::iterator next_write();
+
+  /// Main loop of a writer thread.
+  void writer_loop();
+
+  /// Complete all queued writes and stop the writer threads.
+  void stop_writers();
+
+  /// Delete the copies of the data of the completed writes, so that their
+  /// arrays are recycled by the calling thread for later copies.
+  void release_snapshots();
+  //\}
+#endif  // USE_PTHREADS
+
   std::map<std::string, std::string> _options;
+  /// Communicators of the aggregation groups, by communicator and ratio
+  std::map<std::pair<MPI_Comm, int>, MPI_Comm> _agg_comms;
+
+  /// The last write of an array, for the deltas of the SNAP format
+  struct Array_state {
+    Array_state() : m_hash(0) {}
+    unsigned long long m_hash;  ///< Hash of the data written
+    SNAP_ref m_ref;             ///< Where it was written
+  };
+  /// The last writes of the arrays, by material, pane and array name
+  std::map<std::string, Array_state> _arrays;
+  /// The dumps of a material, for the deltas of the SNAP format
+  struct Dump_state {
+    Dump_state() : m_count(-1) {}
+    std::string m_timeLevel;  ///< Time level of the last dump
+    int m_count;              ///< Number of dumps since the last full one
+  };
+  /// The dumps by material
+  std::map<std::string, Dump_state> _dumps;
+  CGNS_files *_cgns_files;  ///< The CGNS files kept open between writes
+  HDF4_files *_hdf4_files;  ///< The HDF4 files kept open between writes
+  /// The windows written to the files kept open
+  std::set<std::string> _file_windows;
+  std::atomic<int> _nsubmitted;  ///< Number of writes submitted
+  std::atomic<int> _ncompleted;  ///< Number of writes completed
 #ifdef USE_PTHREADS
-  std::vector<pthread_t> _writers;
-  static Semaphore _writesem;
+  std::vector<std::thread> _writers;          ///< Writer threads
+  std::deque<WriteAttrInfo *> _queue;         ///< Writes not yet started
+  std::set<std::string> _busy_files;          ///< Files of running writes
+  std::vector<COM::Window *> _done_snapshots;  ///< Copies of completed writes
+  bool _stop;                                 ///< Whether writers should exit
+  std::mutex _mutex;
+  std::condition_variable _work_cond;   ///< Signaled when a write is queued
+  std::condition_variable _space_cond;  ///< Signaled when a write starts
+  std::condition_variable _done_cond;   ///< Signaled when a write completes
+  std::mutex _arrays_mutex;             ///< Guards _arrays
 #endif  // USE_PTHREADS
 };
 
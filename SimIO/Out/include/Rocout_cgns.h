@@ -9,10 +9,74 @@
  *  Declaration of Rocout CGNS routines.
  */
 #if !defined(_ROCOUT_CGNS_H)
+#define _ROCOUT_CGNS_H
 
+#include <list>
+#include <map>
 #include <string>
+#include <vector>
 #include "com.h"
 
+/**
+ ** CGNS files kept open between writes, with the time values of their
+ ** bases.
+ **
+ ** Appending a time level to an open file does not read back the time
+ ** values written before. They are kept in memory, and written to the
+ ** BaseIterativeData_t nodes when the file is closed. When more files
+ ** than the limit are open, the least recently used ones are closed.
+ **/
+class CGNS_files {
+ public:
+  explicit CGNS_files(std::size_t limit) : m_limit(limit) {}
+  ~CGNS_files() { close_all("warn"); }
+
+  /** Open a file for modification, or obtain it if it is open.
+   **
+   ** \param fname the file name.
+   ** \param mode 0 to create the file, or 1 to modify it.
+   ** \param errorhandle "ignore", "warn", or "abort" on errors.
+   ** \param keep a file number not to close to respect the limit.
+   ** \return the file number.
+   **/
+  int open(const std::string &fname, int mode, const std::string &errorhandle,
+           int keep = -1);
+
+  /// The file number of a file, or -1 if it is not open.
+  int find(const std::string &fname) const;
+
+  /** The time values of a base of an open file, read from the file the
+   ** first time if read is true. The values are written back when the
+   ** file is closed if modified is set.
+   **/
+  struct Times {
+    Times() : m_modified(false) {}
+
+    std::vector<double> m_values;
+    bool m_modified;
+  };
+  Times &times(int fn, int B, bool read, const std::string &errorhandle);
+
+  /// Close all the files.
+  void close_all(const std::string &errorhandle);
+
+ private:
+  CGNS_files(const CGNS_files &);
+  CGNS_files &operator=(const CGNS_files &);
+
+  struct File {
+    std::string m_name;
+    int m_fn;
+    std::map<int, Times> m_bases;  ///< The time values, by base
+  };
+
+  /// Write the modified time values of a file and close it.
+  void close(std::list<File>::iterator f, const std::string &errorhandle);
+
+  std::list<File> m_files;  ///< The open files, most recently used first
+  std::size_t m_limit;      ///< The maximum number of open files
+};
+
 /**
  ** Write the data for the given attribute to file.
  **
@@ -28,10 +92,13 @@
  ** \param ghosthandle "ignore" or "write" on ghost data.
  ** \param errorhandle "ignore", "warn", or "abort" on errors.
  ** \param mode Write == 0, append == 1. (Input)
+ ** \param files The files kept open between writes, or NULL to close the
+ **        files before returning. (Input)
  **/
 void write_dataitem_CGNS(const std::string &fname, const std::string &mfile,
                          const COM::DataItem *attr, const char *material,
                          const char *timelevel, int pane_id,
                          const std::string &ghosthandle,
-                         const std::string &errorhandle, int mode);
+                         const std::string &errorhandle, int mode,
+                         CGNS_files *files = NULL);
 #endif  // !defined(_ROCOUT_CGNS_H)
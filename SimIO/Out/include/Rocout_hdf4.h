@@ -6,13 +6,66 @@
 //
 
 #if !defined(_ROCOUT_HDF4_H)
+#define _ROCOUT_HDF4_H
 
+#include <list>
 #include <string>
+#include "HDF4.h"
 #include "com.h"
 
+/**
+ ** HDF4 files kept open between writes with the scientific data set
+ ** interface.
+ **
+ ** The datasets of a write are appended to the open file instead of
+ ** opening and closing the file for each of them. When more files than the
+ ** limit are open, the least recently used ones are closed.
+ **/
+class HDF4_files {
+ public:
+  explicit HDF4_files(std::size_t limit) : m_limit(limit) {}
+  ~HDF4_files() { close_all("warn"); }
+
+  /** Open a file for writing, or obtain it if it is open.
+   **
+   ** \param fname the file name.
+   ** \param mode 0 to create the file, or 1 to append to it.
+   ** \param errorhandle "ignore", "warn", or "abort" on errors.
+   ** \return the SD interface identifier, or FAIL.
+   **/
+  int32 open(const std::string &fname, int mode,
+             const std::string &errorhandle);
+
+  /// Close all the files.
+  void close_all(const std::string &errorhandle);
+
+ private:
+  HDF4_files(const HDF4_files &);
+  HDF4_files &operator=(const HDF4_files &);
+
+  struct File {
+    std::string m_name;
+    int32 m_sd_id;
+  };
+
+  /// Close a file.
+  void close(std::list<File>::iterator f, const std::string &errorhandle);
+
+  std::list<File> m_files;  ///< The open files, most recently used first
+  std::size_t m_limit;      ///< The maximum number of open files
+};
+
+/**
+ ** Write the data for the given attribute to file in the HDF4 format.
+ **
+ ** \param files The files kept open between writes, or NULL to write with
+ **        the single file interface, which opens and closes the file for
+ **        each dataset.
+ **/
 void write_dataitem_HDF4(const std::string &fname, const std::string &mfile,
                          const COM::DataItem *attr, const char *material,
                          const char *timelevel, int pane_id,
-                         const std::string &errorhandle, int mode);
+                         const std::string &errorhandle, int mode,
+                         HDF4_files *files = NULL);
 
 #endif  // !defined(_ROCOUT_HDF4_H)
@@ -0,0 +1,67 @@
+//
+//  Copyright@2013, Illinois Rocstar LLC. All rights reserved.
+//
+//  See LICENSE file included with this source or
+//  (opensource.org/licenses/NCSA) for license information.
+//
+
+/** \file Rocout_snap.h
+ *  Declaration of Rocout routines for the native snapshot format.
+ *  @see Snapshot.h
+ */
+#if !defined(_ROCOUT_SNAP_H)
+#define _ROCOUT_SNAP_H
+
+#include <map>
+#include <string>
+#include "Snapshot.h"
+#include "com.h"
+
+/**
+ ** The file and time level of the last write of an array, which a delta
+ ** refers to when the array has not changed since.
+ **/
+struct SNAP_ref {
+  std::string m_file;
+  std::string m_timeLevel;
+};
+
+/// The arrays of a pane written as references, by name.
+typedef std::map<std::string, SNAP_ref> SNAP_refs;
+
+/**
+ ** Write the data for the given attribute to file.
+ **
+ ** Write the given attribute to file using the snapshot format.  The
+ ** attribute may be a "mesh", "all" or some other predefined attribute.
+ **
+ ** \param fname The name of the main datafile. (Input)
+ ** \param mfile The name of the optional mesh datafile. (Input)
+ ** \param attr The attribute to write out. (Input)
+ ** \param material The name of the material. (Input)
+ ** \param timelevel The simulation time for this data. (Input)
+ ** \param pane_id The id for the local pane. (Input)
+ ** \param errorhandle "ignore", "warn", or "abort" on errors.
+ ** \param mode Write == 0, append == 1. (Input)
+ ** \param direct Whether to write with O_DIRECT. (Input)
+ ** \param compression The compression of the arrays. (Input)
+ ** \param refs The arrays to write as references, or NULL. (Input)
+ ** \return true if the pane was written.
+ **/
+bool write_dataitem_SNAP(const std::string &fname, const std::string &mfile,
+                         const COM::DataItem *attr, const char *material,
+                         const char *timelevel, int pane_id,
+                         const std::string &errorhandle, int mode, bool direct,
+                         const Snapshot::Compression &compression,
+                         const SNAP_refs *refs = NULL);
+
+/**
+ ** Compute a hash of each array that write_dataitem_SNAP writes for the
+ ** given mesh file, attribute and pane, by name. Arrays that are not set
+ ** are skipped.
+ **/
+void hash_dataitem_SNAP(const std::string &mfile, const COM::DataItem *attr,
+                        int pane_id,
+                        std::map<std::string, unsigned long long> &hashes);
+
+#endif  // !defined(_ROCOUT_SNAP_H)
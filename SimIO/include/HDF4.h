@@ -14,8 +14,8 @@
 #if !defined(_HDF4_H)
 #define _HDF4_H
 
-#include <list>
 #include <string>
+#include <vector>
 #ifdef USE_PTHREADS
 #include <pthread.h>
 #include "Sync.h"
@@ -28,24 +28,25 @@
 #define MAX_NC_VARS H4_MAX_NC_VARS
 #endif
 
-class HDF4Cmd;
-
 /**
  ** A class to serialize HDF calls for multithreaded apps.
  **
  ** Since the HDF4 libraries aren't thread-safe, it's necessary to make sure
- ** that two threads don't use HDF routines concurrently.  This class
- ** starts an I/O thread and passes HDF commands to it.  It also provides a
- ** few utility functions, and supports caching of open file descriptors.
+ ** that two threads don't use HDF routines concurrently.  Each wrapper
+ ** calls the HDF routine in the calling thread while holding a lock, so
+ ** that a call costs no thread switch.  The batch functions make several
+ ** calls on one file under a single lock, so that they are not interleaved
+ ** with the calls of other threads.  This class also provides a few
+ ** utility functions.
  **/
 class HDF4 {
  public:
   virtual ~HDF4() = 0;
 
-  /// Create and start the I/O thread.
+  /// Prepare for the use of HDF4 by a module.
   static void init();
 
-  /// Destroy the I/O thread.
+  /// End the use of HDF4 by a module.
   static void finalize();
 
   //@{
@@ -85,6 +86,38 @@ class HDF4 {
                           VOIDP data);
   //@}
 
+  /// A read of a dataset, for ReadDatasets().
+  struct DatasetRead {
+    int32 m_index;     ///< The index of the dataset in the file.
+    int32 m_start[3];  ///< The first item read in each dimension.
+    int32 m_edge[3];   ///< The number of items read in each dimension.
+    VOIDP m_data;      ///< The buffer to read into.
+  };
+
+  //@{
+  /// Batches of HDF4 calls on one file.
+  /// Select, read and end the access to each dataset.  Return FAIL if
+  /// any of the reads failed.
+  static intn ReadDatasets(int32 sd_id, const std::vector<DatasetRead> &reads);
+
+  /// Write a dataset with the single file interface, setting its
+  /// dimensions, number type, strings and range for this dataset only.
+  /// The dataset is appended to the file if append is true.
+  static intn DFSDwritedata(const char *filename, intn rank, int32 dimsizes[],
+                            int32 numbertype, const char *label,
+                            const char *unit, const char *format,
+                            const char *coordsys, VOIDP maxi, VOIDP mini,
+                            VOIDP data, bool append);
+
+  /// Create a dataset in a file opened with SDstart(), set its strings and
+  /// range, write its data and end the access to it.
+  static intn SDwritedataset(int32 sd_id, int32 rank, int32 dimsizes[],
+                             int32 numbertype, const char *label,
+                             const char *unit, const char *format,
+                             const char *coordsys, VOIDP maxi, VOIDP mini,
+                             VOIDP data);
+  //@}
+
   //@{
   /// "Open" and "close" HDF files efficiently.
   // static int32 Start(const std::string& pathname);
@@ -99,26 +132,20 @@ class HDF4 {
   /// Get the size in bytes of an HDF data type.
   static int SizeOf(int32 dType);
 
-  /// Terminate the I/O thread.
-  static void Terminate();
-
   /// return error message
   static std::string error_msg();
 
 #if USE_PTHREADS
  private:
-  /// The thread entry point.
-  static void *Entry(void *arg);
-
-  /// Common code when posting HDF commands.
-  static void PostCommand(HDF4Cmd *pCmd);
-
-  static Semaphore sm_pending;  ///< A semaphore to track pending commands.
-  static std::list<HDF4Cmd *> sm_cmdQueue;  ///< The command queue.
-  static Mutex sm_cs;                       ///< Avoid concurrent accesses.
-  static pthread_t sm_id;                   ///< The I/O thread id.
-  static int sm_counter;                    ///< The number of HDF4 objects.
-#endif                                      // USE_PTHREADS
+  /// Hold the lock on the HDF4 library during the lifetime of the object.
+  class Lock {
+   public:
+    Lock() { sm_cs.Lock(); }
+    ~Lock() { sm_cs.Unlock(); }
+  };
+
+  static Mutex sm_cs;  ///< Avoid concurrent accesses.
+#endif                 // USE_PTHREADS
 };
 
 #endif  // !defined(_HDF4_H)
@@ -0,0 +1,168 @@
+//
+//  Copyright@2013, Illinois Rocstar LLC. All rights reserved.
+//
+//  See LICENSE file included with this source or
+//  (opensource.org/licenses/NCSA) for license information.
+//
+
+/**
+ ** @file Snapshot.h
+ ** @brief Declaration of the native snapshot format of SimIO.
+ **
+ ** A snapshot file is a sequence of segments, one per pane written. A
+ ** segment starts with a 64-byte header, followed by an index of its
+ ** arrays and by the arrays themselves. The index and each array start at
+ ** a multiple of 64 bytes from the start of the file, so that a mapped
+ ** file provides aligned arrays. Appending to a file adds segments at its
+ ** end. Files are written in the byte order of the machine, which is
+ ** checked when they are read.
+ **
+ ** An array whose data has not changed since it was last written may be
+ ** written without its data, as a reference to the file and time level of
+ ** the segment that holds it. A segment whose arrays are references is a
+ ** delta of that segment.
+ **
+ ** Arrays may be stored compressed, after their bytes are shuffled so
+ ** that the bytes of the same significance of all the values are next to
+ ** each other. They are decompressed when the file is read.
+ **/
+
+#if !defined(_SNAPSHOT_H)
+#define _SNAPSHOT_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ ** An array of a pane in a snapshot file.
+ **
+ ** Arrays with several components are stored with the components of each
+ ** item next to each other.
+ **/
+struct Snapshot_array {
+  Snapshot_array()
+      : m_position('p'),
+        m_dataType(0),
+        m_ncomp(1),
+        m_nitems(0),
+        m_ng(0),
+        m_nbytes(0),
+        m_data(0) {}
+
+  std::string m_name;   ///< Name of the dataitem or connectivity table.
+  std::string m_units;  ///< Units of measurement.
+  char m_position;      ///< Location, 'w', 'p', 'n', or 'e'.
+  int m_dataType;       ///< Roccom datatype.
+  int m_ncomp;          ///< Number of components.
+  long long m_nitems;   ///< Total number of items.
+  long long m_ng;       ///< Number of ghost items.
+  long long m_nbytes;   ///< Size of the data in bytes, 0 if not set.
+  const void *m_data;   ///< The data.
+  std::string m_refFile;       ///< File with the data, if referred to.
+  std::string m_refTimeLevel;  ///< Time level of the data referred to.
+};
+
+/**
+ ** A segment of a snapshot file, which holds arrays of one pane.
+ **/
+struct Snapshot_pane {
+  Snapshot_pane() : m_paneId(0) {}
+
+  std::string m_material;   ///< Material (window) name.
+  std::string m_timeLevel;  ///< Time level of the data.
+  std::string m_meshFile;   ///< File with the mesh, if not in this file.
+  int m_paneId;             ///< Pane ID.
+  std::vector<Snapshot_array> m_arrays;  ///< The arrays of the pane.
+};
+
+/**
+ ** Writing of snapshot files.
+ **/
+class Snapshot {
+ public:
+  /// The compression of arrays.
+  enum Codec {
+    NONE = 0,       ///< Stored as they are.
+    ZLIB = 1,       ///< Compressed with zlib.
+    SHUFFLE = 0x100 ///< Flag for bytes shuffled before compression.
+  };
+
+  /**
+   ** The compression used to write arrays.
+   **/
+  struct Compression {
+    Compression() : m_codec(NONE), m_level(1) {}
+
+    int m_codec;  ///< A Codec, possibly with SHUFFLE.
+    int m_level;  ///< Compression level, from 1 (fastest) to 9 (smallest).
+  };
+
+  /** Parse a compression: "off", or "zlib" optionally preceded by
+   ** "shuffle+" and followed by ":" and a level, such as "shuffle+zlib:3".
+   **
+   ** \return false if the string is not valid, or if this build has no
+   **         zlib support.
+   **/
+  static bool parse_compression(const std::string &s, Compression &c);
+
+  /** Write a pane as a segment of a snapshot file.
+   **
+   ** \param fname the file name.
+   ** \param pane the pane to write.
+   ** \param mode 0 to create the file, or 1 to append to it.
+   ** \param direct whether to bypass the page cache with O_DIRECT, where
+   **        supported. The segment is then padded to the block size.
+   ** \param compression the compression of the arrays. Arrays that would
+   **        not shrink are stored as they are.
+   ** \return true on success.
+   **/
+  static bool write(const std::string &fname, const Snapshot_pane &pane,
+                    int mode, bool direct = false,
+                    const Compression &compression = Compression());
+
+  /// The alignment of the index and the arrays.
+  static const int ALIGNMENT = 64;
+
+  /// The alignment of the segments written with O_DIRECT.
+  static const int DIRECT_ALIGNMENT = 4096;
+};
+
+/**
+ ** A snapshot file mapped into memory for reading.
+ **
+ ** The file is mapped privately, so its arrays may be used and modified in
+ ** place without changing the file. Compressed arrays are decompressed
+ ** into buffers of the object. They remain valid until the object is
+ ** deleted.
+ **/
+class Snapshot_file {
+ public:
+  Snapshot_file() : m_addr(0), m_size(0) {}
+  ~Snapshot_file();
+
+  /// Map a file and read its index. Return false if it is not a valid
+  /// snapshot file, or if one of its arrays could not be decompressed.
+  bool open(const std::string &fname);
+
+  /// The name of the file.
+  const std::string &name() const { return m_name; }
+
+  /// The segments of the file, in the order they were written.
+  const std::vector<Snapshot_pane> &panes() const { return m_panes; }
+
+  /// Whether a file name has the extension of snapshot files.
+  static bool is_snapshot(const std::string &fname);
+
+ private:
+  Snapshot_file(const Snapshot_file &);
+  Snapshot_file &operator=(const Snapshot_file &);
+
+  std::string m_name;
+  void *m_addr;        ///< Address of the mapping.
+  std::size_t m_size;  ///< Size of the mapping.
+  std::vector<Snapshot_pane> m_panes;
+  std::vector<void *> m_buffers;  ///< The decompressed arrays.
+};
+
+#endif  // !defined(_SNAPSHOT_H)
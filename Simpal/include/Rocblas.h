@@ -9,6 +9,7 @@
  *  Definition for Rocblas API.
  */
 #include <cstdio>
+#include "Rocblas_kernels.h"
 #include "com.h"
 
 USE_COM_NAME_SPACE
@@ -93,6 +94,25 @@ class Rocblas {
   static void nrm2_scalar_MPI(const DataItem *x, void *y, const MPI_Comm *comm,
                               const DataItem *mults = NULL);
 
+  /** Computes the dot products of n pairs of dataitems with a single
+   *  reduction over comm. xhdls and yhdls hold the handles of the pairs and
+   *  z receives the n results. If req is not NULL, the reduction is started
+   *  without blocking and completes in wait_multi_MPI, which must be called
+   *  before z is used.
+   */
+  static void dot_multi_MPI(const int *n, const int *xhdls, const int *yhdls,
+                            double *z, const MPI_Comm *comm = NULL,
+                            MPI_Request *req = NULL);
+
+  /// Computes the 2-norms (sums of squares, as nrm2) of n dataitems with a
+  /// single reduction. @see dot_multi_MPI
+  static void nrm2_multi_MPI(const int *n, const int *xhdls, double *z,
+                             const MPI_Comm *comm = NULL,
+                             MPI_Request *req = NULL);
+
+  /// Waits for the reduction started by dot_multi_MPI or nrm2_multi_MPI.
+  static void wait_multi_MPI(MPI_Request *req);
+
   /// Wrapper for swap.
   static void swap(DataItem *x, DataItem *y);
 
@@ -149,6 +169,27 @@ class Rocblas {
   static void axpy_scalar(const void *a, const DataItem *x, const DataItem *y,
                           DataItem *z);
 
+  /** Evaluates a fused expression in one pass over the panes.
+   *
+   *  The expression is a sequence of statements separated by ';'. The
+   *  dataitems z and u can be assigned element-wise expressions of the
+   *  dataitems x, y, w, z, u, the scalars s0, s1, ..., and constants, using
+   *  +, -, *, /, sqrt, abs, max, min and limit1. A scalar can be assigned a
+   *  reduction sum(e), dot(e1, e2), nrm2(e) (sum of squares, as nrm2),
+   *  maxval(e) or minval(e), which is reduced over comm and stored into s
+   *  after the pass. For example, "z = x - z; s0 = nrm2(x); s1 = nrm2(z)".
+   *  Double, float and integer dataitems are supported, and evaluated in
+   *  double precision; dataitems that are not assigned may have a single
+   *  component.
+   */
+  static void fused_MPI(const char *expr, const DataItem *x, const DataItem *y,
+                        const DataItem *w, DataItem *z, DataItem *u, double *s,
+                        const MPI_Comm *comm = NULL);
+
+  /// Evaluates a fused expression without reducing over processes.
+  static void fused(const char *expr, const DataItem *x, const DataItem *y,
+                    const DataItem *w, DataItem *z, DataItem *u, double *s);
+
  protected:
   ///  Performs the operation:  z = x op y
   template <class FuncType, int ytype>
@@ -224,6 +265,13 @@ class Rocblas {
 
   enum { BLAS_VOID, BLAS_SCALAR, BLAS_VEC, BLAS_SCNE, BLAS_VEC2D };
 
+  /// Operation of Rocblas_batch that implements a function object, or
+  /// Rocblas_op::NONE if the function object has no kernel.
+  template <class FuncType>
+  struct kernel_op {
+    enum { value = Rocblas_op::NONE };
+  };
+
   template <int attr_type>
   inline static int get_stride(const DataItem *attr);
 
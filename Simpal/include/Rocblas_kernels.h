@@ -0,0 +1,97 @@
+//
+//  Copyright@2013, Illinois Rocstar LLC. All rights reserved.
+//
+//  See LICENSE file included with this source or
+//  (opensource.org/licenses/NCSA) for license information.
+//
+
+/** \file Rocblas_kernels.h
+ *  Definition of the kernels of Rocblas for contiguous arrays.
+ *  @see Rocblas_kernels.C
+ */
+
+#ifndef __ROCBLAS_KERNELS_H__
+#define __ROCBLAS_KERNELS_H__
+
+#include <vector>
+
+/// Operations implemented by Rocblas_batch.
+struct Rocblas_op {
+  enum {
+    NONE = -1,  ///< Not implemented by a kernel
+    COPY,       ///< z = x
+    FILL,       ///< z = a
+    ADD,        ///< z = x + y
+    SUB,        ///< z = x - y
+    MUL,        ///< z = x * y
+    DIV,        ///< z = x / y
+    ADD_S,      ///< z = x + a
+    SUB_S,      ///< z = x - a
+    RSUB_S,     ///< z = a - x
+    MUL_S,      ///< z = x * a
+    DIV_S,      ///< z = x / a
+    RDIV_S,     ///< z = a / x
+    AXPY_S,     ///< z = a * x + y
+    AXPY,       ///< z = w * x + y
+    MULADD,     ///< z += x * y
+    DOT         ///< sum of x * y
+  };
+};
+
+/** A Rocblas operation on the contiguous arrays of the panes of a window.
+ *
+ *  The Rocblas templates validate the panes one by one and add the arrays
+ *  of the contiguous panes to a batch, which then executes them together.
+ *  Panes are distributed among OpenMP threads, and large panes are split
+ *  into chunks so that a single pane is also processed in parallel. Small
+ *  batches run on the calling thread. The loops are compiled for AVX-512
+ *  and AVX2 in addition to the baseline instruction set where the compiler
+ *  supports it, and the variant is selected at run time.
+ *
+ *  Dot products are summed chunk by chunk in a fixed order, so their
+ *  results do not depend on the number of threads.
+ *
+ *  The instruction set is selected at run time for double and int; char
+ *  arrays use the baseline loops.
+ */
+template <class T>
+class Rocblas_batch {
+ public:
+  /// Chunk of entries processed by a thread.
+  enum { CHUNK_SIZE = 8192 };
+  /// Minimum number of entries for which threads are used.
+  enum { PARALLEL_SIZE = 65536 };
+
+  explicit Rocblas_batch(int op) : _op(op), _nentries(0) {}
+
+  /// Add n entries of arrays to the batch. Operands not used by the
+  /// operation may be NULL.
+  void add(T *z, const T *x, const T *y, const T *w, long long n) {
+    if (n <= 0) return;
+    Segment s = {z, x, y, w, n};
+    _segs.push_back(s);
+    _nentries += n;
+  }
+
+  /// Number of entries in the batch.
+  long long size() const { return _nentries; }
+
+  /** Execute the operation on all arrays. The scalar a is dereferenced
+   *  only by the operations that use it and if the batch is not empty.
+   *  Returns the sum of the products for DOT and zero otherwise.
+   */
+  T run(const T *a = 0) const;
+
+ private:
+  struct Segment {
+    T *z;
+    const T *x, *y, *w;
+    long long n;
+  };
+
+  int _op;
+  long long _nentries;
+  std::vector<Segment> _segs;
+};
+
+#endif
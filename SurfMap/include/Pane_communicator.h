@@ -36,7 +36,9 @@ class Pane_communicator {
   /// outbuf.
   struct Pane_comm_buffers {
     // Default constructor
-    Pane_comm_buffers() : rank(-1), tag(-1), index(-1) {}
+    Pane_comm_buffers()
+        : rank(-1), tag(-1), index(-1), peer_pane(-1), peer_buf(-1),
+          dtype_strd(-1) {}
 
     int rank;                  // rank for communicating process
     int tag;                   // tag for MPI message
@@ -45,6 +47,14 @@ class Pane_communicator {
                                // pconn of the local pane
     std::vector<char> outbuf;  // buffer for outgoing messages
     std::vector<char> inbuf;   // buffer for incoming messages
+    int peer_pane;             // local index of the communicating pane
+                               // if it is on the same process
+    int peer_buf;              // index of the buffer of peer_pane for
+                               // messages from the local pane
+    MPI_Datatype dtype;        // datatype of the ghost entries in the
+                               // array of the local pane
+    int dtype_strd;            // stride in bytes dtype was built for,
+                               // or -1 if dtype is not built
   };
 
  public:
@@ -75,6 +85,7 @@ class Pane_communicator {
     // std::cout << "Size of _gcr_buffer " << _gcr_buffs.size() << "\n";
 
     // cleaning up
+    free_types();
     for (int i = 0; i < _shr_buffs.size(); i++) {
       std::vector<Pane_comm_buffers> pcbv = _shr_buffs[i];
       for (int j = 0; j < pcbv.size(); j++) {
@@ -132,6 +143,12 @@ class Pane_communicator {
   ///  my_pconn stores pane-connectivity
   void init(COM::DataItem *att, const COM::DataItem *my_pconn = NULL);
 
+  ///  Point the communicator to the current arrays of a dataitem, keeping
+  ///  the buffers built by init. The dataitem must have the same data type
+  ///  and number of components as the one the communicator was initialized
+  ///  with, and the pane connectivity must not have changed since.
+  void set_data(COM::DataItem *att);
+
   /// Obtain the MPI communicator for the object
   MPI_Comm mpi_comm() const { return _comm; }
 
@@ -230,6 +247,29 @@ class Pane_communicator {
   void begin_update(const Buff_type btype,
                     std::vector<std::vector<bool> > *involved = NULL);
 
+  /// Obtain the receives completed since the last call, as indices in
+  /// the format of _reqs_indices. Returns false if none is pending.
+  bool wait_received(std::vector<std::pair<int, int> > &done);
+
+  /// Obtain the receives that can be processed in the order they were
+  /// posted, which is the order of the panes and of their buffers, so that
+  /// reductions do not depend on the order in which messages arrive.
+  /// Returns false if none is pending.
+  bool wait_received_in_order(std::vector<std::pair<int, int> > &done);
+
+  /// Obtain the buffers of local pane i for a given type of communication.
+  std::vector<Pane_comm_buffers> &buffers(int btype, int i);
+
+  /// Link the buffers of the panes on this process with each other.
+  void init_local_peers();
+
+  /// Obtain the MPI datatype of the entries of a ghost buffer in the
+  /// array of local pane i.
+  MPI_Datatype entries_type(Pane_comm_buffers &pcb, int i);
+
+  /// Free the MPI datatypes of all buffers.
+  void free_types();
+
   /// The id of the pconn being used.
   int _my_pconn_id;
 
@@ -237,6 +277,8 @@ class Pane_communicator {
   COM::Window *_appl_window;
   /// MPI Communicator
   const MPI_Comm _comm;
+  /// Rank of this process in _comm
+  int _rank;
   /// Vector of all local panes
   std::vector<COM::Pane *> _panes;
   /// The total number of panes on all processes
@@ -270,6 +312,14 @@ class Pane_communicator {
   std::vector<MPI_Request> _reqs_send, _reqs_recv;
   /// The indices in buffs for each pending nonblocking receive request.
   std::vector<std::pair<int, int> > _reqs_indices;
+  /// The indices in buffs for each pending receive from a local pane,
+  /// whose data have been copied by the sender.
+  std::vector<std::pair<int, int> > _local_recvs;
+  /// The indices in buffs of all receives in the order they were posted,
+  /// whether each has arrived, and the first one not processed yet.
+  std::vector<std::pair<int, int> > _recv_order;
+  std::vector<char> _recv_arrived;
+  std::size_t _recv_next;
 
  private:
   // Disable the following operators
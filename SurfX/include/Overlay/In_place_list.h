@@ -99,6 +99,7 @@ class In_place_list {
   T* node;
   std::size_t length;
   int dim;
+  bool own_node;  // Whether node was allocated by the list
 
   T* get_node() { return new T; }
   T* get_node(const T& t) { return new T(t); }
@@ -122,13 +123,20 @@ class In_place_list {
   typedef In_place_list<T, managed> Self;
 
   // creation
-  explicit In_place_list(int d = 0) : length(0), dim(d) {
+  explicit In_place_list(int d = 0) : length(0), dim(d), own_node(true) {
     // creats an empty list.
     node = get_node();
     (*node).next_link[dim] = node;
     (*node).prev_link[dim] = node;
   }
-  In_place_list(const Self& x) : length(0), dim(x.dim) {
+  // Creates an empty list using the given item as its head, so that the
+  //   heads of many lists can be stored contiguously by the caller.
+  In_place_list(T* head, int d) : node(head), length(0), dim(d),
+                                  own_node(false) {
+    (*node).next_link[dim] = node;
+    (*node).prev_link[dim] = node;
+  }
+  In_place_list(const Self& x) : length(0), dim(x.dim), own_node(true) {
     node = get_node();
     (*node).next_link[dim] = node;
     (*node).prev_link[dim] = node;
@@ -137,7 +145,7 @@ class In_place_list {
 
   ~In_place_list() {
     erase(begin(), end());
-    put_node(node);
+    if (own_node) put_node(node);
   }
 
   void set_dimension(int d) { dim = d; }
@@ -13,6 +13,8 @@
 #include <queue>
 #include <vector>
 #include "HDS_accessor.h"
+#include "KD_tree_3.h"  // surfmap
+#include "Overlay_arena.h"
 #include "Overlay_primitives.h"
 #include "RFC_Window_overlay.h"
 
@@ -29,9 +31,11 @@ class Overlay {  // Updated: Feb. 25, 2001
  public:
   typedef Overlay Self;
   typedef std::pair<HEdge, HEdge> Parent_pair;
-  typedef std::list<const INode *> INode_const_list;
-  typedef std::vector<const INode *> Subface;
-  typedef std::list<Subface> Subface_list;
+  typedef std::list<const INode *, Arena_allocator<const INode *> >
+      INode_const_list;
+  typedef std::vector<const INode *, Arena_allocator<const INode *> >
+      Subface;
+  typedef std::list<Subface, Arena_allocator<Subface> > Subface_list;
   typedef RFC_Window_overlay::Feature_0 Feature_0;
   typedef RFC_Window_overlay::Feature_1 Feature_1;
   typedef RFC_Window_overlay::Feature_list_0 Feature_list_0;
@@ -49,6 +53,16 @@ class Overlay {  // Updated: Feb. 25, 2001
   // Set tolerance for snapping vertices.
   void set_tolerance(double tol);
 
+  // Set the number of threads for the steps that process the panes
+  // independently: feature detection, normals, and the counting of the
+  // subfaces. The intersection itself is a
+  // single front that depends on the order of traversal, so it stays
+  // serial. The overlay does not depend on the number of threads.
+  void set_threads(int n) {
+    B->set_threads(n);
+    G->set_threads(n);
+  }
+
   // Interfaces for the data transfer algorithms
   RFC_Window_overlay *get_rfc_window(const COM::Window *w) {
     return (B->base() == w) ? B : G;
@@ -98,6 +112,9 @@ class Overlay {  // Updated: Feb. 25, 2001
   // Helper for overlay_init which computes the parent of a point x
   void get_green_parent(const Node &v, const HEdge &b, HEdge *o, Parent_type *t,
                         Point_2 *nc);
+  // Build and delete the index of green vertices for get_green_parent.
+  void build_green_index();
+  void delete_green_index();
 
   // This function ensures the consistency of the green parent of x.
   void insert_node_in_blue_edge(INode &x, const HEdge &b);
@@ -126,6 +143,11 @@ class Overlay {  // Updated: Feb. 25, 2001
 
   bool verify_inode(const INode *i);
 
+  // Inodes live in the arena of the overlay, which is released at once
+  // when the overlay is done.
+  INode *new_inode() { return arena.create<INode>(); }
+  void delete_inode(INode *i) { arena.destroy(i); }
+
   // Helpers for determine_edge_parents.
   Host_face get_edge_parent(const INode &i0, const INode &i1,
                             const int color) const;
@@ -184,6 +206,7 @@ class Overlay {  // Updated: Feb. 25, 2001
   void number_subnodes();
   void number_subfaces();
 
+ protected:  // The numbering of the subnodes, emptied after each overlay.
   std::vector<Node_ID> _subnode_ids_b;
   std::vector<Node_ID> _subnode_ids_g;
   std::vector<char> _subnode_copies_b;
@@ -219,6 +242,7 @@ class Overlay {  // Updated: Feb. 25, 2001
   RFC_Window_overlay *B;      // input blue window.
   RFC_Window_overlay *G;      // input green window.
   std::list<INode *> inodes;  // Container for all the inode objects.
+  Overlay_arena arena;        // Storage for inodes and subface lists.
   Overlay_primitives op;
   HDS_accessor acc;
 
@@ -229,6 +253,11 @@ class Overlay {  // Updated: Feb. 25, 2001
 
   Real eps_e;
   Real eps_p;
+
+  KD_tree_3 *green_tree;              // Index of the green vertices
+  std::vector<Node> green_nodes;      // Complete green vertices
+  std::vector<Point_3> green_points;  // and their coordinates.
+  Real green_size;                    // Extent of the green vertices
 };
 
 RFC_END_NAME_SPACE
@@ -0,0 +1,141 @@
+//
+//  Copyright@2013, Illinois Rocstar LLC. All rights reserved.
+//
+//  See LICENSE file included with this source or
+//  (opensource.org/licenses/NCSA) for license information.
+//
+
+//=====================================================================
+// This file contains the region allocator for the transient objects
+// of the overlay algorithm, i.e., the inodes and the subface lists.
+//=====================================================================
+
+#ifndef __OVERLAY_ARENA_H_
+#define __OVERLAY_ARENA_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "rfc_basic.h"
+
+RFC_BEGIN_NAME_SPACE
+
+// Memory is carved out of large blocks by bumping a pointer, and all
+// the blocks are returned at once by release(). Small objects freed
+// before that are kept on free lists segregated by size and reused,
+// so that short-lived lists do not grow the arena. An arena is not
+// thread-safe; concurrent threads must use separate arenas.
+class Overlay_arena {
+ public:
+  explicit Overlay_arena(std::size_t block_size = 65536);
+  ~Overlay_arena() { release(); }
+
+  void *allocate(std::size_t n);
+  void deallocate(void *p, std::size_t n);
+
+  template <class T>
+  T *create() {
+    return new (allocate(sizeof(T))) T();
+  }
+  template <class T>
+  void destroy(T *p) {
+    p->~T();
+    deallocate(p, sizeof(T));
+  }
+
+  // Free all the blocks. The objects in the arena are not destructed.
+  void release();
+
+  // Counters since construction, which survive release().
+  std::size_t size_of_allocations() const { return _num_allocs; }
+  std::size_t size_of_blocks() const { return _num_blocks; }
+  // Bytes in use and reserved now, which are zero after release().
+  std::size_t bytes_in_use() const { return _bytes; }
+  std::size_t bytes_reserved() const { return _reserved; }
+  // Largest number of bytes in use and reserved at any time.
+  std::size_t peak_bytes() const { return _peak_bytes; }
+  std::size_t peak_reserved() const { return _peak_reserved; }
+
+  // Add the counters of an arena that was used for part of the work.
+  // Its peak is taken on top of the bytes currently in use here.
+  void merge_statistics(const Overlay_arena &a);
+
+ private:
+  Overlay_arena(const Overlay_arena &);
+  Overlay_arena &operator=(const Overlay_arena &);
+
+  enum { ALIGNMENT = 16, NUM_CLASSES = 32 };
+
+  struct Free_node {
+    Free_node *next;
+  };
+
+  static std::size_t size_class(std::size_t n) {
+    return (n + ALIGNMENT - 1) / ALIGNMENT;
+  }
+  char *new_block(std::size_t n);
+
+  std::vector<char *> _blocks;
+  char *_cur, *_end;
+  std::size_t _block_size;
+  Free_node *_free[NUM_CLASSES];  // Free lists by multiples of ALIGNMENT
+
+  std::size_t _num_allocs, _num_blocks;
+  std::size_t _bytes, _reserved, _peak_bytes, _peak_reserved;
+};
+
+// An STL allocator drawing from an Overlay_arena. A default-constructed
+// allocator has no arena and falls back to the global operator new.
+template <class T>
+class Arena_allocator {
+ public:
+  typedef T value_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template <class U>
+  struct rebind {
+    typedef Arena_allocator<U> other;
+  };
+
+  Arena_allocator() : _arena(NULL) {}
+  explicit Arena_allocator(Overlay_arena *a) : _arena(a) {}
+  template <class U>
+  Arena_allocator(const Arena_allocator<U> &x) : _arena(x.arena()) {}
+
+  T *allocate(std::size_t n) {
+    if (_arena) return static_cast<T *>(_arena->allocate(n * sizeof(T)));
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+  void deallocate(T *p, std::size_t n) {
+    if (_arena)
+      _arena->deallocate(p, n * sizeof(T));
+    else
+      ::operator delete(p);
+  }
+
+  Overlay_arena *arena() const { return _arena; }
+
+ private:
+  Overlay_arena *_arena;
+};
+
+template <class T, class U>
+inline bool operator==(const Arena_allocator<T> &a,
+                       const Arena_allocator<U> &b) {
+  return a.arena() == b.arena();
+}
+
+template <class T, class U>
+inline bool operator!=(const Arena_allocator<T> &a,
+                       const Arena_allocator<U> &b) {
+  return a.arena() != b.arena();
+}
+
+RFC_END_NAME_SPACE
+
+#endif  // __OVERLAY_ARENA_H_
@@ -15,6 +15,7 @@
 #ifndef RFC_WINDOW_H
 #define RFC_WINDOW_H
 
+#include <algorithm>
 #include <cmath>
 #include <list>
 #include <map>
@@ -327,6 +328,8 @@ class RFC_Pane_overlay : public RFC_Pane_base, protected SURF::Pane_manifold_2 {
   //=========== Functions for supporting the overlay algorithm
   void create_overlay_data();
   void delete_overlay_data();
+  // Number of bytes taken by the data of the overlay algorithm.
+  std::size_t size_of_overlay_data() const;
 
   void construct_bvpair2edge();
   int get_border_index(const HEdge &h) const {
@@ -367,6 +370,7 @@ class RFC_Pane_overlay : public RFC_Pane_base, protected SURF::Pane_manifold_2 {
   std::vector<INode *> _v_nodes;         // INodes at vertices
   std::vector<INode *> _e_node_buf;      // INode buffer for edges
   std::vector<INode_list> _e_node_list;  // INodes on edges
+  std::vector<INode> _e_node_heads;      // Heads of _e_node_list
   std::vector<int> _e_marks;             // Marks for edges
 
   int _size_of_subfaces;
@@ -394,11 +398,17 @@ class RFC_Window_overlay : public RFC_Window_derived<RFC_Pane_overlay>,
 
   void create_overlay_data();
   void delete_overlay_data();
+  std::size_t size_of_overlay_data() const;
 
   void determine_counterparts();
   void unmark_alledges();
 
   HEdge get_an_unmarked_halfedge() const;
+
+  /// Set the number of threads that process the panes in the
+  /// preprocessing of the overlay. The results do not depend on it.
+  void set_threads(int n) { _nthreads = std::max(n, 1); }
+  int threads() const { return _nthreads; }
   /** @} end of pio */
 
   /** @defgroup ntc Normal and Tangent Computation
@@ -554,6 +564,7 @@ class RFC_Window_overlay : public RFC_Window_derived<RFC_Pane_overlay>,
   bool _strong_ended;
   // Whether to snap blue features onto green features
   bool _snap_on_features;
+  int _nthreads;  // Threads for the loops over the panes
 
   static const float r2d;
 };
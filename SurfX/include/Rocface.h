@@ -35,10 +35,18 @@ class Rocface : public COM_Object {
   typedef std::map<std::string, RFC_Window_transfer *> TRS_Windows;
 
   struct Control_parameters {
-    Control_parameters() : verb(0), snap(1.e-3) {}
+    Control_parameters()
+        : verb(0),
+          snap(1.e-3),
+          operators(0),
+          preconditioner(0),
+          overlay_threads(1) {}
 
     int verb;
     double snap;
+    int operators;        // Whether to compile transfers into sparse operators
+    int preconditioner;   // Preconditioner of least-squares transfers
+    int overlay_threads;  // Threads for the overlay
   };
 
  public:
@@ -51,6 +59,35 @@ class Rocface : public COM_Object {
   // set verbose level
   void set_verbose(int *verbose);
 
+  /// Whether to compile the transfers into sparse operators. If *on is
+  /// nonzero, the first transfer between two windows with given parameters
+  /// compiles the overlay into sparse matrices, which the later transfers
+  /// of any field with the same parameters reuse. The operators assume
+  /// that the coordinates of the windows do not change. They are discarded
+  /// with the overlay and by every call, so call it again after the
+  /// meshes have moved. Transfers with tags set are not compiled.
+  void set_operators(int *on);
+
+  /// Set the preconditioner of the conjugate gradient solver of the
+  /// least-squares transfers to nodes: 0 for Jacobi (the default), or 1
+  /// for the ILU(0) of the mass matrix of each pane, which takes fewer
+  /// iterations but more setup. With the operators, the factorization is
+  /// computed once and kept with them.
+  void set_preconditioner(int *pc);
+
+  /// Set the number of threads that compute the overlays. They process
+  /// the panes concurrently in the feature detection, the normals, the
+  /// search for seeds and the subdivision of the faces. The overlay does
+  /// not depend on the number of threads. Needs OpenMP; the default is 1.
+  void set_overlay_threads(int *n);
+
+  /// Obtain the statistics of the last transfer: the number of iterations
+  /// and the relative residual of the solver (0 if it did not run), and
+  /// the seconds spent in setting up the solver, in the solver, and in the
+  /// whole transfer.
+  void get_statistics(int *iter, double *resid, double *setup,
+                      double *solve, double *total);
+
   // read Rocface control file
   void read_control_file(const char *fname);
 
@@ -131,6 +168,10 @@ class Rocface : public COM_Object {
   Control_parameters _ctrl;
   TRS_Windows _trs_windows;
 
+  // Statistics of the last transfer. See get_statistics.
+  int _iterations;
+  double _residual, _setup_time, _solve_time, _total_time;
+
   int _cookie;
 };
 
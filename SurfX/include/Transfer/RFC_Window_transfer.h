@@ -15,6 +15,7 @@
 #define RFC_WINDOW_TRANSFER_H
 
 #include "RFC_Window_base.h"
+#include "Transfer_operators.h"
 #include "Vector_n.h"
 #include "commpi.h"
 
@@ -138,6 +139,17 @@ class RFC_Window_transfer : public RFC_Window_derived<RFC_Pane_transfer> {
   // Set _to_recv tags for the next data transfer algorithm.
   // If tag is NULL, reset the tags to NULL.
   void set_tags(const COM::DataItem *tag);
+  // Whether tags are set for the next data transfer algorithm.
+  bool has_tags() const { return _has_tags; }
+
+  // ========  Compiled operators of the transfers into this window
+  // Get the operators of the transfers with the given key, which are
+  // created empty if they do not exist yet.
+  Transfer_operators &operators(const std::string &key) {
+    return _operators[key];
+  }
+  // Discard all the compiled operators.
+  void clear_operators() { _operators.clear(); }
 
   // ============ Communication subroutines for source panes ==================
   /// Returns whether replication has been performed.
@@ -166,6 +178,14 @@ class RFC_Window_transfer : public RFC_Window_derived<RFC_Pane_transfer> {
   void reduce_to_all(Nodal_data &, MPI_Op);
   void reduce_maxabs_to_all(Nodal_data &);
 
+  /// reduce_to_all in two steps, so that computations that leave the
+  /// shared nodes unchanged can overlap the communication. If shared is
+  /// not NULL, it is set to a bitmap of the shared nodes of each pane, in
+  /// the order of panes().
+  void begin_reduce_to_all(Nodal_data &,
+                           std::vector<std::vector<bool> > *shared = NULL);
+  void end_reduce_to_all(MPI_Op);
+
   // ===== Lower level communication routines =============
   //! Block until all processes of the window have reached here.
   void barrier() const;
@@ -214,6 +234,9 @@ class RFC_Window_transfer : public RFC_Window_derived<RFC_Pane_transfer> {
   std::set<std::pair<int, RFC_Pane_transfer *> > _panes_to_send;  //<to_rank, p>
   const std::string _prefix;
   const int _IO_format;
+
+  bool _has_tags;
+  std::map<std::string, Transfer_operators> _operators;
 };
 
 //================================================================
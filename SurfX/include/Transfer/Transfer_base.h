@@ -39,12 +39,52 @@ class Transfer_base {
       Pane_const_iterator;
 
   Transfer_base(RFC_Window_transfer *s, RFC_Window_transfer *t)
-      : src(*s), trg(*t), sc(s->color()), _src_pane(NULL), _trg_pane(NULL) {
+      : src(*s),
+        trg(*t),
+        sc(s->color()),
+        _ops(NULL),
+        _mass(NULL),
+        _pc(PC_JACOBI),
+        _src_pane(NULL),
+        _trg_pane(NULL) {
     src.panes(src_ps);
     trg.panes(trg_ps);
   }
 
  public:
+  /// The preconditioners of the PCG solver of transfer_2n.
+  enum Preconditioner {
+    PC_JACOBI = 0,  // Diagonal of the mass matrix
+    PC_ILU0 = 1     // ILU(0) of the mass matrix of each pane
+  };
+
+  /// Statistics of the last transfer to nodes.
+  struct Statistics {
+    Statistics()
+        : iterations(0),
+          residual(0),
+          setup_time(0),
+          solve_time(0),
+          total_time(0) {}
+
+    int iterations;     // Iterations of PCG
+    Real residual;      // Relative residual of PCG
+    double setup_time;  // Load vector, mass matrix and preconditioner
+    double solve_time;  // PCG
+    double total_time;  // Whole transfer, set by the caller
+  };
+
+  /** Use the given operators, compiling the parts that are missing, instead
+   *  of evaluating the transfer from the overlay. NULL to transfer
+   *  without operators.
+   */
+  void set_operators(Transfer_operators *ops) { _ops = ops; }
+
+  /// Set the preconditioner of PCG, one of Preconditioner.
+  void set_preconditioner(int pc) { _pc = pc; }
+
+  const Statistics &statistics() const { return _stats; }
+
   /** template function for transfering from nodes/faces to faces.
    *  \param sDF   Souce data
    *  \param tDF   Target data
@@ -114,12 +154,92 @@ class Transfer_base {
   void init_load_vector(const _SDF &vS, const Real alpha, Nodal_data &ld,
                         Nodal_data &diag, int doa, bool lump);
 
-  // This is a matrix-free solver that solves the equation M*x=ld,
-  // where M is the mass matrix computed on the fly.
+  // The following compile the transfers into the operators _ops, with
+  // the same arguments as the functions they replace.
+
+  /// Compile the interpolation of interpolate_fe.
+  template <class _SDF>
+  void compile_interpolation(const _SDF &vS);
+
+  /// Compile the load vector and the mass matrix of init_load_vector.
+  template <class _SDF>
+  void compile_loads(const _SDF &vS, const Real alpha, int doa);
+
+  /// Compile the averages over the target faces of transfer_2f.
+  template <class _SDF>
+  void compile_averages(const _SDF &vS, const Real alpha, int doa);
+
+  /// Computes the element-wise matrices of the load vector and of the
+  /// mass matrix over a subface, whose entries are appended to loads and
+  /// mass. This is the counterpart of element_load_vector.
+  template <class Tag>
+  void element_load_matrix(
+      const RFC_Pane_transfer *p_src,  //< Source pane
+      const RFC_Pane_transfer *p_trg,  //< Target pane
+      ENE &ene_src,                    //< node enumerator of source element
+      ENE &ene_trg,                    //< node enumerator of target element
+      int sfid_src,                    //< parent face ID in source pane
+      int sfid_trg,                    //< parent face ID in target pane
+      const Real alpha,                //< coordinate interpolation parameter
+      const Tag &tag,                  //< Tag_facial/Tag_nodal
+      int doa,                         //< Degree of accuracy of quadrature
+      std::vector<Sparse_matrix::Entry> &loads,
+      std::vector<Sparse_matrix::Entry> &mass);
+
+  /// Computes the weights of the source values in the integral over a
+  /// subface, which are appended to weights, and adds its area to area.
+  /// This is the counterpart of integrate_subface. fid_src is the parent
+  /// face of the subface for facial data.
+  template <class Tag>
+  void subface_weights(const RFC_Pane_transfer *p_src,
+                       const RFC_Pane_transfer *p_trg, ENE &ene_src,
+                       ENE &ene_trg, int sfid_src, int sfid_trg, int fid_src,
+                       const Real alpha, const Tag &tag, int doa,
+                       std::vector<Sparse_matrix::Entry> &weights, Real &area);
+
+  /// Computes y += A*x for the matrices A from the source panes, where x
+  /// is the source data.
+  template <class _SDF>
+  void multiply_add(const Transfer_operators::Source_matrices &ms,
+                    const _SDF &sDF, Real *y) {
+    for (Transfer_operators::Source_matrices::const_iterator it = ms.begin();
+         it != ms.end(); ++it)
+      it->second.multiply_add(get_src_pane(it->first)->pointer(sDF.id()), y,
+                              sDF.dimension());
+  }
+
+  /// The weights of the nodes of e in the interpolation at nc.
+  static void interpolation_weights(const Generic_element &e,
+                                    const Generic_element::Nat_coor &nc,
+                                    Real *w) {
+    Real f[Generic_element::MAX_SIZE];
+    std::fill(f, f + e.size_of_nodes(), Real(0));
+    for (unsigned int k = 0; k < e.size_of_nodes(); ++k) {
+      f[k] = 1;
+      e.interpolate(f, nc, &w[k]);
+      f[k] = 0;
+    }
+  }
+
+  // This solves the equation M*x=ld with the mass matrices of the target
+  // panes in _mass, assembled by assemble_mass_matrices or compiled.
   int pcg(Nodal_data &x, Nodal_data &b, Nodal_data &p, Nodal_data &q,
           Nodal_data &r, Nodal_data &s, Nodal_data &z, Nodal_data &di,
           Real *tol, int *max_iter);
 
+  /// Assemble the mass matrix of each target pane from the element mass
+  /// matrices computed by init_load_vector, for the PCG of one transfer.
+  void assemble_mass_matrices();
+
+  /// Set up the preconditioner _pc for the mass matrices in _mass, falling
+  /// back to Jacobi if it cannot be computed.
+  /// \param diag is the diagonal of the mass matrix.
+  void init_preconditioner(const Nodal_data_const &diag);
+
+  /// Apply the preconditioner set up by init_preconditioner.
+  void precondition(const Nodal_data_const &rhs, const Nodal_data_const &diag,
+                    Nodal_data &x);
+
   /// Diagonal (Jacobi) preconditioner
   /// \param rhs is the right-hand side of the system
   /// \param diag is the diagonal of the mass matrix.
@@ -127,8 +247,16 @@ class Transfer_base {
   void precondition_Jacobi(const Nodal_data_const &rhs,
                            const Nodal_data_const &diag, Nodal_data &x);
 
+  /// Additive Schwarz preconditioner with the ILU(0) of each pane. The
+  /// residual and the correction of a shared node are both weighted by
+  /// the share of the pane in its diagonal, so that it is symmetric and
+  /// reduces to Jacobi for diagonal matrices.
+  void precondition_ILU(const Nodal_data_const &rhs, Nodal_data &x);
+
   //============== Helper routines for cg==================
-  // Multiply the mass matrix M with a vector X, and get y.
+  // Multiply the mass matrix M with a vector X, and get y. After the
+  // first call, the rows of the shared nodes are computed first so that
+  // the other rows overlap their communication.
   void multiply_mass_mat_and_x(const Nodal_data_const &x, Nodal_data &y);
 
   Real square(const Array_n_const &x) const { return x * x; }
@@ -245,6 +373,16 @@ class Transfer_base {
   RFC_Window_transfer &src;
   RFC_Window_transfer &trg;
   int sc;
+  Transfer_operators *_ops;  // Compiled operators, or NULL if not used
+
+  // The mass matrices used by PCG, either in _ops or in _assembled.
+  Transfer_operators *_mass;
+  Transfer_operators _assembled;
+
+  int _pc;  // Preconditioner, one of Preconditioner
+  std::vector<std::vector<bool> > _shared;  // Shared nodes of target panes
+  std::vector<std::vector<Real> > _pc_weights;  // Weights of ILU(0)
+  Statistics _stats;
 
  private:
   // Caches for the pane
@@ -0,0 +1,124 @@
+//
+//  Copyright@2013, Illinois Rocstar LLC. All rights reserved.
+//
+//  See LICENSE file included with this source or
+//  (opensource.org/licenses/NCSA) for license information.
+//
+
+//=====================================================================
+// This file contains the sparse operators into which the transfers
+// between two windows are compiled from their overlay.
+//=====================================================================
+
+#ifndef __TRANSFER_OPERATORS_H_
+#define __TRANSFER_OPERATORS_H_
+
+#include <map>
+#include <vector>
+#include "rfc_basic.h"
+
+RFC_BEGIN_NAME_SPACE
+
+// A sparse matrix in compressed-row format. Only the nonempty rows are
+// stored, so that a matrix from a source pane to a target pane takes
+// space in proportion to their overlap. Rows and columns are 0-based
+// indices of nodes or faces.
+class Sparse_matrix {
+ public:
+  // An entry to be assembled.
+  struct Entry {
+    Entry(int r, int c, Real v) : row(r), col(c), val(v) {}
+    bool operator<(const Entry &e) const {
+      return row < e.row || (row == e.row && col < e.col);
+    }
+
+    int row, col;
+    Real val;
+  };
+
+  Sparse_matrix() : _offsets(1, 0) {}
+
+  // Build the matrix from its entries, summing duplicates. The entries
+  // are sorted in place.
+  void assemble(std::vector<Entry> &entries);
+
+  // Compute y += A*x, where x and y have dim components per item.
+  void multiply_add(const Real *x, Real *y, int dim) const;
+
+  // Compute y += A*x only for the rows i with rows[i] equal to selected.
+  void multiply_add(const Real *x, Real *y, int dim,
+                    const std::vector<bool> &rows, bool selected) const;
+
+  // Add the diagonal of the matrix to the first components of d, or its
+  // row sums if lump is true.
+  void add_diagonal(Real *d, int dim, bool lump) const;
+
+  int size_of_rows() const { return _rows.size(); }
+  int size_of_entries() const { return _cols.size(); }
+
+ private:
+  friend class Sparse_ilu;
+
+  void multiply_rows(const Real *x, Real *y, int dim,
+                     const std::vector<bool> *rows, bool selected) const;
+
+  std::vector<int> _rows;     // Indices of the nonempty rows
+  std::vector<int> _offsets;  // Start of each row in _cols and _vals
+  std::vector<int> _cols;
+  std::vector<Real> _vals;
+};
+
+// An incomplete LU factorization without fill-in, ILU(0), of a square
+// sparse matrix whose nonempty rows are also its nonempty columns, such
+// as a mass matrix. It is used to precondition PCG.
+class Sparse_ilu {
+ public:
+  Sparse_ilu() : _factored(false) {}
+
+  // Factor A. Returns false if a pivot is not positive, in which case the
+  // factorization is not usable.
+  bool factor(const Sparse_matrix &A);
+
+  // Solve (LU)*x=b for the nonempty rows of A, where x and b have dim
+  // components per item and x may be b. The other rows of x are left
+  // unchanged.
+  void solve(const Real *b, Real *x, int dim) const;
+
+  bool factored() const { return _factored; }
+
+ private:
+  bool _factored;
+  Sparse_matrix _lu;           // L and U, with the unit diagonal of L implied
+  std::vector<int> _diags;     // Position of the diagonal of each row
+};
+
+// The operators of a transfer into the panes of a target window. They
+// are compiled on first use and depend only on the overlay, the
+// coordinates, and the parameters of the transfer, so the transfers of
+// all the fields with the same parameters share them.
+struct Transfer_operators {
+  // Matrices from the panes of the source window, by source pane ID.
+  typedef std::map<int, Sparse_matrix> Source_matrices;
+
+  // The operators of a target pane.
+  struct Pane_operators {
+    Source_matrices interp;    // Interpolation to the nodes
+    Source_matrices loads;     // Load vector
+    Source_matrices averages;  // Averages over the faces
+    Sparse_matrix mass;        // Mass matrix, assembled over the pane
+    Sparse_ilu ilu;            // ILU(0) of the mass matrix, if used
+  };
+
+  Transfer_operators()
+      : has_interp(false), has_loads(false), has_averages(false) {}
+
+  // Total number of entries of the matrices.
+  long size_of_entries() const;
+
+  bool has_interp, has_loads, has_averages;
+  std::map<int, Pane_operators> panes;  // By target pane ID
+};
+
+RFC_END_NAME_SPACE
+
+#endif  // __TRANSFER_OPERATORS_H_